@@ -85,6 +85,8 @@ public:
           friendship_score_calculator(social_graph) {
         // Build search index on construction
         user_search.buildIndex(social_graph);
+        // Landmark index for fast distance bounds and pruned searches
+        path_calculator.build_landmark_index();
     }
 
     /**
@@ -116,6 +118,11 @@ public:
         return mutual_friends_analyzer.analyze(user1, user2);
     }
 
+    vector<MutualFriendsResult> analyze_mutual_friends_many(
+        int user, const vector<int>& candidates) const {
+        return mutual_friends_analyzer.analyze_many(user, candidates);
+    }
+
     // Friend Recommendations
     vector<FriendRecommendation> get_friend_recommendations(
         int user_id, int count = 10) const 
@@ -151,6 +158,12 @@ public:
         return centrality_analyzer.calculate_metrics(user_id);
     }
 
+    vector<CentralityMetrics> get_centrality_metrics_batch(
+        const vector<int>& user_ids) const
+    {
+        return centrality_analyzer.calculate_metrics_batch(user_ids);
+    }
+
     // Shortest Path
     PathFindResult find_shortest_path(int source, int target) const {
         return path_calculator.find_path(source, target);
@@ -8,11 +8,14 @@
 #pragma once
 
 #include "../graph_generator.hpp"
+#include "../thread_pool.hpp"
+#include "../traversal.hpp"
 #include "short_path.hpp"
 #include <vector>
 #include <algorithm>
 #include <cmath>
 #include <set>
+#include <mutex>
 
 using namespace std;
 
@@ -33,9 +36,22 @@ struct CentralityMetrics
 class CentralityAnalyzer
 {
 private:
+    // Exact Brandes runs one BFS per node; above this size we fall back
+    // to sampled pivot sources and scale the accumulated dependencies.
+    static constexpr int BETWEENNESS_EXACT_LIMIT = 2000;
+    static constexpr int BETWEENNESS_SAMPLE_COUNT = 256;
+
     const SocialGraph &graph;
     mutable OptimizedDistanceCalculator path_calculator;
 
+    // Betweenness is inherently an all-sources computation, so it is
+    // computed once per analyzer (the graph is immutable per snapshot)
+    // and cached by dense node index.
+    mutable vector<double> betweenness_scores;
+    mutable bool betweenness_computed = false;
+    mutable uint64_t betweenness_version = 0;
+    mutable mutex betweenness_mutex;
+
     /**
      * Count triangles in friend neighborhood (for clustering coefficient).
      * Optimized: only checks when nodes have sufficient connections.
@@ -80,28 +96,183 @@ private:
         return triangle_count;
     }
 
-public:
-    explicit CentralityAnalyzer(const SocialGraph &social_graph)
-        : graph(social_graph), path_calculator(social_graph) {}
-
     /**
-     * CENTRALITY ANALYSIS
+     * One Brandes pass: BFS from source index s over the following
+     * relation, then dependency accumulation in reverse BFS order.
+     * Contributions are added into local_scores (indexed by dense node
+     * index) so independent sources can run on separate threads.
      *
-     * Calculate various centrality measures for a user.
-     * Shows how important/central a user is in the network.
-     *
-     * Metrics:
-     * - Degree centrality: normalized number of connections
-     * - Closeness: average distance to all other users
-     * - Clustering coefficient: do my friends know each other?
-     * - Betweenness: how often am I on shortest paths?
-     *
-     * Time Complexity: O(V + E) per user
-     * Space Complexity: O(V)
-     *
-     * Returns: CentralityMetrics with all measures
+     * All scratch state is caller-owned and reused across sources: the
+     * BFS scratch resets in O(touched), and sigma/delta/predecessors
+     * are restored to their all-zero/empty state during the backward
+     * walk (each entry is only dirty at visited indices), so a pass
+     * over a sparse region costs proportionally to what it visits
+     * instead of O(V) in allocations and clears.
      */
-    CentralityMetrics calculate_metrics(int user_id) const
+    void brandes_from_source(int s, BFSScratch &bfs,
+                             vector<long long> &sigma,
+                             vector<double> &delta,
+                             vector<vector<int>> &predecessors,
+                             vector<double> &local_scores) const
+    {
+        bfs.reset(graph.getIndexedNodeCount());
+        sigma[s] = 1;
+        bfs.mark(s, 0, -1);
+        bfs.enqueue(s);
+
+        while (bfs.pending())
+        {
+            int u = bfs.pop();
+            int next_depth = bfs.dist(u) + 1;
+
+            for (int neighbor_id : graph.followingAtIndex(u))
+            {
+                int v = graph.getNodeIndex(neighbor_id);
+                if (v < 0) continue;
+                if (!bfs.seen(v))
+                {
+                    bfs.mark(v, next_depth, u);
+                    bfs.enqueue(v);
+                }
+                if (bfs.dist(v) == next_depth)
+                {
+                    sigma[v] += sigma[u];
+                    predecessors[v].push_back(u);
+                }
+            }
+        }
+
+        // Accumulate dependencies walking the BFS order backwards. Each
+        // node's scratch entries are zeroed once it is consumed, leaving
+        // the arrays clean for the next source.
+        const vector<int> &visit_order = bfs.visit_order();
+        for (int i = (int)visit_order.size() - 1; i >= 0; i--)
+        {
+            int w = visit_order[i];
+            for (int p : predecessors[w])
+            {
+                delta[p] += ((double)sigma[p] / sigma[w]) * (1.0 + delta[w]);
+            }
+            if (w != s)
+            {
+                local_scores[w] += delta[w];
+            }
+            sigma[w] = 0;
+            delta[w] = 0.0;
+            predecessors[w].clear();
+        }
+    }
+
+    /**
+     * Compute betweenness for every node, distributing the per-source
+     * Brandes passes across the shared thread pool and merging the
+     * per-chunk accumulators. sample_count <= 0 or >= V means exact
+     * (every node is a source); otherwise that many evenly spaced pivot
+     * sources are used and the result is scaled by V / samples.
+     * Scores are normalized by (V-1)(V-2), the number of ordered pairs
+     * a node could lie between in a directed graph.
+     */
+    vector<double> compute_betweenness(int sample_count = -1) const
+    {
+        int n = graph.getIndexedNodeCount();
+        vector<double> scores(n, 0.0);
+        if (n < 3) return scores;
+
+        vector<int> sources;
+        if (sample_count > 0 && sample_count < n)
+        {
+            // Evenly spaced pivots: deterministic and cheap, good enough
+            // for a rank-ordering estimate
+            sources.reserve(sample_count);
+            for (int i = 0; i < sample_count; i++)
+            {
+                sources.push_back((int)((long long)i * n / sample_count));
+            }
+        }
+        else
+        {
+            sources.resize(n);
+            for (int i = 0; i < n; i++) sources[i] = i;
+        }
+
+        mutex merge_mutex;
+        global_thread_pool().parallel_blocks(sources.size(),
+            [&](int begin, int end)
+            {
+                // Scratch allocated once per chunk; brandes_from_source
+                // leaves it clean between sources
+                BFSScratch bfs;
+                vector<long long> sigma(n, 0);
+                vector<double> delta(n, 0.0);
+                vector<vector<int>> predecessors(n);
+                vector<double> local_scores(n, 0.0);
+                for (int i = begin; i < end; i++)
+                {
+                    brandes_from_source(sources[i], bfs, sigma, delta,
+                                        predecessors, local_scores);
+                }
+                lock_guard<mutex> lock(merge_mutex);
+                for (int v = 0; v < n; v++)
+                {
+                    scores[v] += local_scores[v];
+                }
+            });
+
+        double scale = 1.0 / ((double)(n - 1) * (n - 2));
+        if ((int)sources.size() < n)
+        {
+            scale *= (double)n / sources.size();
+        }
+        for (double &score : scores) score *= scale;
+
+        return scores;
+    }
+
+    /**
+     * Closeness sums from one BFS over the following relation,
+     * accumulated straight out of the shared scratch - no O(V)
+     * distance array per user, which is what keeps the batch path
+     * cheap.
+     */
+    void closeness_from(int user_id, BFSScratch &bfs,
+                        long long &total_distance, int &reachable_count) const
+    {
+        total_distance = 0;
+        reachable_count = 0;
+        int source_index = graph.getNodeIndex(user_id);
+        if (source_index < 0) return;
+
+        bfs.reset(graph.getIndexedNodeCount());
+        bfs.mark(source_index, 0, -1);
+        bfs.enqueue(source_index);
+        while (bfs.pending())
+        {
+            int u = bfs.pop();
+            int next_depth = bfs.dist(u) + 1;
+            for (int neighbor_id : graph.followingAtIndex(u))
+            {
+                int v = graph.getNodeIndex(neighbor_id);
+                if (v >= 0 && !bfs.seen(v))
+                {
+                    bfs.mark(v, next_depth, u);
+                    bfs.enqueue(v);
+                }
+            }
+        }
+
+        for (int v : bfs.visit_order())
+        {
+            if (v == source_index) continue;
+            total_distance += bfs.dist(v);
+            reachable_count++;
+        }
+    }
+
+    // Assemble one metrics record from the closeness sums; betweenness
+    // is served from the caller-resolved cached vector.
+    CentralityMetrics build_metrics(int user_id, long long total_distance,
+                                    int reachable_count,
+                                    const vector<double> &betweenness) const
     {
         CentralityMetrics metrics;
         metrics.user_id = user_id;
@@ -112,27 +283,11 @@ public:
         metrics.raw_degree = degree;
         metrics.degree_centrality = max_possible > 0 ? (double)degree / max_possible : 0.0;
 
-        // Closeness centrality: average distance to all reachable users
-        int total_distance = 0;
-        int reachable_count = 0;
-
-        for (const auto &[other_id, node] : graph.getNodes())
-        {
-            if (other_id == user_id)
-                continue;
-            int dist = path_calculator.calculate_shortest_distance(user_id, other_id);
-            if (dist >= 0)
-            {
-                total_distance += dist;
-                reachable_count++;
-            }
-        }
-
         double avg_distance = reachable_count > 0 ? (double)total_distance / reachable_count : 0.0;
         metrics.closeness_centrality = 1.0 / (1.0 + avg_distance);
 
         // Clustering coefficient: do my friends know each other?
-        auto friends = graph.getFriends(user_id);
+        const auto &friends = graph.getFriends(user_id);
         if (friends.size() < 2)
         {
             metrics.clustering_coefficient = 0.0;
@@ -145,10 +300,104 @@ public:
             metrics.clustering_coefficient = max_triangles > 0 ? (double)triangle_count / max_triangles : 0.0;
         }
 
-        metrics.betweenness_centrality = 0.0; // TODO: implement if needed
+        int self_index = graph.getNodeIndex(user_id);
+        metrics.betweenness_centrality =
+            (self_index >= 0 && self_index < (int)betweenness.size())
+                ? betweenness[self_index] : 0.0;
+
         return metrics;
     }
 
+    // Lazily compute (exact or sampled depending on graph size) and
+    // cache the betweenness vector.
+    const vector<double> &betweenness_all() const
+    {
+        lock_guard<mutex> lock(betweenness_mutex);
+        // Recompute if the graph structure moved on (delta updates)
+        if (betweenness_computed &&
+            betweenness_version != graph.getStructureVersion())
+        {
+            betweenness_computed = false;
+        }
+        if (!betweenness_computed)
+        {
+            int n = graph.getIndexedNodeCount();
+            int samples = (n <= BETWEENNESS_EXACT_LIMIT) ? -1
+                                                         : BETWEENNESS_SAMPLE_COUNT;
+            betweenness_scores = compute_betweenness(samples);
+            betweenness_version = graph.getStructureVersion();
+            betweenness_computed = true;
+        }
+        return betweenness_scores;
+    }
+
+public:
+    explicit CentralityAnalyzer(const SocialGraph &social_graph)
+        : graph(social_graph), path_calculator(social_graph) {}
+
+    /**
+     * CENTRALITY ANALYSIS
+     *
+     * Calculate various centrality measures for a user.
+     * Shows how important/central a user is in the network.
+     *
+     * Metrics:
+     * - Degree centrality: normalized number of connections
+     * - Closeness: average distance to all other users
+     * - Clustering coefficient: do my friends know each other?
+     * - Betweenness: how often am I on shortest paths?
+     *
+     * Time Complexity: O(V + E) per user
+     * Space Complexity: O(V)
+     *
+     * Returns: CentralityMetrics with all measures
+     */
+    CentralityMetrics calculate_metrics(int user_id) const
+    {
+        // Closeness from one single-source BFS (previously V separate
+        // pair queries); betweenness from the cached Brandes vector
+        static thread_local BFSScratch bfs;
+        long long total_distance;
+        int reachable_count;
+        closeness_from(user_id, bfs, total_distance, reachable_count);
+        return build_metrics(user_id, total_distance, reachable_count,
+                             betweenness_all());
+    }
+
+    /**
+     * Batch form: metrics for a whole page of users in one pass. The
+     * betweenness vector is resolved once, then the per-user closeness
+     * BFS runs fan out over the shared compute pool with one scratch
+     * per chunk. Blocks on parallel_blocks, so it must not be called
+     * from a worker of the same pool (the api_server keeps its request
+     * workers in a separate pool for exactly this reason).
+     */
+    vector<CentralityMetrics> calculate_metrics_batch(
+        const vector<int> &user_ids) const
+    {
+        vector<CentralityMetrics> results(user_ids.size());
+        if (user_ids.empty()) return results;
+
+        const auto &betweenness = betweenness_all();
+
+        global_thread_pool().parallel_blocks(user_ids.size(),
+            [&](int begin, int end)
+            {
+                BFSScratch bfs;
+                for (int i = begin; i < end; i++)
+                {
+                    long long total_distance;
+                    int reachable_count;
+                    closeness_from(user_ids[i], bfs, total_distance,
+                                   reachable_count);
+                    results[i] = build_metrics(user_ids[i], total_distance,
+                                               reachable_count, betweenness);
+                }
+            });
+
+        return results;
+    }
+
     /**
      * Calculate centrality for all users.
      * Returns vector of metrics for each user.
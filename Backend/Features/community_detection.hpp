@@ -8,12 +8,16 @@
 #pragma once
 
 #include "../graph_generator.hpp"
+#include "../thread_pool.hpp"
+#include "../traversal.hpp"
 #include <vector>
 #include <map>
 #include <unordered_map>
-#include <unordered_set>
 #include <queue>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
 
 using namespace std;
 
@@ -44,13 +48,23 @@ private:
         if (members.size() < 2) return 0.0;
 
         int internal_edges = 0;
-        unordered_set<int> member_set(members.begin(), members.end());
+
+        // Dense membership marks over node indices: reset is O(members),
+        // each probe a bit test instead of a hash lookup
+        static thread_local BFSScratch member_marks;
+        member_marks.reset(graph.getIndexedNodeCount());
+        for (int member : members) {
+            int index = graph.getNodeIndex(member);
+            if (index >= 0) member_marks.mark(index, 0, -1);
+        }
 
         // Count friend edges within community
         for (int member : members) {
-            auto friends = graph.getFriends(member);
+            NeighborSpan friends = graph.friendsOf(member);
             for (int friend_id : friends) {
-                if (member_set.count(friend_id) && member < friend_id) {
+                int friend_index = graph.getNodeIndex(friend_id);
+                if (friend_index >= 0 && member_marks.seen(friend_index) &&
+                    member < friend_id) {
                     internal_edges++;
                 }
             }
@@ -66,12 +80,19 @@ private:
     pair<int, int> count_community_edges(const vector<int>& members) const {
         int internal = 0;
         int external = 0;
-        unordered_set<int> member_set(members.begin(), members.end());
 
+        static thread_local BFSScratch member_marks;
+        member_marks.reset(graph.getIndexedNodeCount());
         for (int member : members) {
-            auto friends = graph.getFriends(member);
+            int index = graph.getNodeIndex(member);
+            if (index >= 0) member_marks.mark(index, 0, -1);
+        }
+
+        for (int member : members) {
+            NeighborSpan friends = graph.friendsOf(member);
             for (int friend_id : friends) {
-                if (member_set.count(friend_id)) {
+                int friend_index = graph.getNodeIndex(friend_id);
+                if (friend_index >= 0 && member_marks.seen(friend_index)) {
                     // Don't double count
                     if (member < friend_id) internal++;
                 } else {
@@ -83,6 +104,166 @@ private:
         return {internal, external};
     }
 
+    // ===== LOUVAIN MACHINERY =====
+
+    // Compact weighted graph passed between Louvain levels. Level 0 is
+    // the friend graph (unit weights); aggregated levels collapse each
+    // community into one node, with intra-community weight folded into
+    // self_loops. Adjacency stores both directions of every edge, so a
+    // node's weighted degree is 2*self_loop + sum of incident weights
+    // and total_weight is 2m.
+    struct LevelGraph {
+        int node_count = 0;
+        double total_weight = 0.0;                    // 2m
+        vector<vector<pair<int, double>>> adjacency;  // (neighbor, weight)
+        vector<double> self_loops;
+    };
+
+    /**
+     * Louvain local-move phase: sweep the nodes repeatedly, moving each
+     * to the neighbor community with the highest modularity gain, until
+     * a full sweep moves nothing. The gain of joining community c is
+     * proportional to w(i->c) - tot_c * k_i / 2m, evaluated from the
+     * cached per-community degree sums - no modularity recomputation
+     * per candidate move. Fills `community` (initially singletons) and
+     * returns whether any node moved.
+     */
+    bool local_move_phase(const LevelGraph& g, vector<int>& community) const {
+        int n = g.node_count;
+        vector<double> degree(n, 0.0);
+        for (int i = 0; i < n; i++) {
+            degree[i] = 2.0 * g.self_loops[i];
+            for (const auto& [j, w] : g.adjacency[i]) degree[i] += w;
+        }
+
+        community.resize(n);
+        for (int i = 0; i < n; i++) community[i] = i;
+        vector<double> community_total = degree;  // sum of k_i per community
+
+        // Reusable scratch: weight from the current node into each
+        // candidate community, reset via the touched list
+        vector<double> weight_to(n, 0.0);
+        vector<int> touched;
+
+        bool any_moved = false;
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            for (int i = 0; i < n; i++) {
+                int current = community[i];
+
+                for (const auto& [j, w] : g.adjacency[i]) {
+                    int c = community[j];
+                    if (weight_to[c] == 0.0) touched.push_back(c);
+                    weight_to[c] += w;
+                }
+                // Staying put must always be a candidate
+                if (weight_to[current] == 0.0) touched.push_back(current);
+
+                // Evaluate gains with i taken out of its community
+                community_total[current] -= degree[i];
+                int best_community = current;
+                double best_gain = weight_to[current] -
+                    community_total[current] * degree[i] / g.total_weight;
+                for (int c : touched) {
+                    if (c == current) continue;
+                    double gain = weight_to[c] -
+                        community_total[c] * degree[i] / g.total_weight;
+                    if (gain > best_gain + 1e-12) {
+                        best_gain = gain;
+                        best_community = c;
+                    }
+                }
+                community_total[best_community] += degree[i];
+
+                if (best_community != current) {
+                    community[i] = best_community;
+                    improved = true;
+                    any_moved = true;
+                }
+
+                for (int c : touched) weight_to[c] = 0.0;
+                touched.clear();
+            }
+        }
+        return any_moved;
+    }
+
+    /**
+     * Aggregation phase: renumber communities densely (rewriting
+     * `community` to the dense ids) and collapse each into one node of
+     * the next level, summing parallel edge weights and folding
+     * intra-community weight into self loops.
+     */
+    LevelGraph aggregate_level(const LevelGraph& g, vector<int>& community) const {
+        int n = g.node_count;
+        vector<int> renumber(n, -1);
+        int next_id = 0;
+        for (int i = 0; i < n; i++) {
+            if (renumber[community[i]] < 0) renumber[community[i]] = next_id++;
+            community[i] = renumber[community[i]];
+        }
+
+        LevelGraph agg;
+        agg.node_count = next_id;
+        agg.total_weight = g.total_weight;
+        agg.adjacency.assign(next_id, {});
+        agg.self_loops.assign(next_id, 0.0);
+
+        vector<double> weight_to(next_id, 0.0);
+        vector<int> touched;
+        vector<vector<int>> members(next_id);
+        for (int i = 0; i < n; i++) members[community[i]].push_back(i);
+
+        for (int c = 0; c < next_id; c++) {
+            for (int i : members[c]) {
+                agg.self_loops[c] += g.self_loops[i];
+                for (const auto& [j, w] : g.adjacency[i]) {
+                    int cj = community[j];
+                    if (cj == c) {
+                        // Both directions of an intra edge pass through
+                        // here, and a self loop counts its weight once
+                        agg.self_loops[c] += w / 2.0;
+                    } else {
+                        if (weight_to[cj] == 0.0) touched.push_back(cj);
+                        weight_to[cj] += w;
+                    }
+                }
+            }
+            for (int cj : touched) {
+                agg.adjacency[c].emplace_back(cj, weight_to[cj]);
+                weight_to[cj] = 0.0;
+            }
+            touched.clear();
+        }
+        return agg;
+    }
+
+    // Modularity contribution of one community on the friend graph:
+    // in_c/m - (deg_c/2m)^2, the per-community term of the quantity
+    // Louvain maximizes. total_edges is m, the undirected edge count.
+    double community_modularity(const vector<int>& members,
+                                int internal_edges, long long total_edges) const {
+        if (total_edges <= 0) return 0.0;
+        long long degree_sum = 0;
+        for (int member : members) {
+            degree_sum += graph.friendsOf(member).size();
+        }
+        double m = (double)total_edges;
+        double fraction = degree_sum / (2.0 * m);
+        return internal_edges / m - fraction * fraction;
+    }
+
+    // Undirected friend edge count (m) for modularity normalization.
+    long long total_friend_edges() const {
+        long long degree_sum = 0;
+        int n = graph.getIndexedNodeCount();
+        for (int i = 0; i < n; i++) {
+            degree_sum += graph.friendsAtIndex(i).size();
+        }
+        return degree_sum / 2;
+    }
+
 public:
     explicit CommunityDetector(const SocialGraph& social_graph) 
         : graph(social_graph) {}
@@ -93,63 +274,120 @@ public:
      * Simple but effective algorithm for community detection.
      * Each node takes the label of its most frequent friend.
      * 
-     * Algorithm: Iterative label propagation
-     * Time Complexity: O(V * avg_degree * iterations)
+     * Algorithm: Iterative label propagation over the dense node index.
+     * Labels live in a flat array of atomics (user-id maps and per-node
+     * std::map counters dominated the old runtime), an active-frontier
+     * worklist skips nodes whose neighborhood did not change last round,
+     * and each round's sweep is split across the shared thread pool.
+     *
+     * Time Complexity: O(active_nodes * avg_degree) per iteration
      * Space Complexity: O(V)
-     * 
+     *
      * Parameters:
      *   - max_iterations: number of rounds (default 10)
-     * 
+     *
      * Returns: Vector of communities with statistics
      */
     vector<Community> detect_label_propagation(int max_iterations = 10) const {
-        unordered_map<int, int> labels; // user_id -> community_id
-        const auto& nodes = graph.getNodes();
-
-        // Initialize: each node is own community
-        for (const auto& [id, node] : nodes) {
-            labels[id] = id;
+        int n = graph.getIndexedNodeCount();
+        if (n == 0) return {};
+
+        // Initialize: each node is own community. Atomics let parallel
+        // sweeps read neighbors' freshest labels without tearing.
+        vector<atomic<int32_t>> labels(n);
+        for (int i = 0; i < n; i++) {
+            labels[i].store(i, memory_order_relaxed);
         }
 
-        // Propagate labels iteratively
+        // Frontier: only nodes whose neighborhood changed last round
+        // can change label this round
+        vector<char> active(n, 1);
+
         for (int iteration = 0; iteration < max_iterations; iteration++) {
-            bool changed = false;
-            
-            for (const auto& [id, node] : nodes) {
-                map<int, int> label_count; // label -> count
-
-                // Count friend labels
-                for (int friend_id : graph.getFriends(id)) {
-                    label_count[labels[friend_id]]++;
-                }
+            vector<int> worklist;
+            worklist.reserve(n);
+            for (int i = 0; i < n; i++) {
+                if (active[i]) worklist.push_back(i);
+            }
+            if (worklist.empty()) break; // Converged
+
+            fill(active.begin(), active.end(), 0);
+            atomic<int> changed{0};
+            mutex merge_mutex;
+
+            global_thread_pool().parallel_blocks(worklist.size(),
+                [&](int begin, int end) {
+                    // Reusable scratch counter: labels are dense indices,
+                    // so counting is an array write and reset walks only
+                    // the touched entries instead of allocating a map
+                    // per node
+                    vector<int> label_count(n, 0);
+                    vector<int> touched;
+                    vector<int> relabeled;
+
+                    for (int w = begin; w < end; w++) {
+                        int i = worklist[w];
+
+                        for (int friend_id : graph.friendsAtIndex(i)) {
+                            int f = graph.getNodeIndex(friend_id);
+                            if (f < 0) continue;
+                            int32_t label = labels[f].load(memory_order_relaxed);
+                            if (label_count[label]++ == 0) {
+                                touched.push_back(label);
+                            }
+                        }
+
+                        // Highest count wins, smallest label on ties
+                        // (matches the old map-based sweep)
+                        int best_label = -1;
+                        int best_count = 0;
+                        for (int label : touched) {
+                            int count = label_count[label];
+                            if (count > best_count ||
+                                (count == best_count && label < best_label)) {
+                                best_count = count;
+                                best_label = label;
+                            }
+                            label_count[label] = 0;
+                        }
+                        touched.clear();
 
-                if (!label_count.empty()) {
-                    // Pick label with highest count
-                    int new_label = max_element(
-                        label_count.begin(), label_count.end(),
-                        [](const auto& a, const auto& b) { 
-                            return a.second < b.second; 
-                        })->first;
-
-                    if (labels[id] != new_label) {
-                        labels[id] = new_label;
-                        changed = true;
+                        if (best_count > 0 &&
+                            labels[i].load(memory_order_relaxed) != best_label) {
+                            labels[i].store(best_label, memory_order_relaxed);
+                            changed.fetch_add(1, memory_order_relaxed);
+                            relabeled.push_back(i);
+                        }
                     }
-                }
-            }
 
-            if (!changed) break; // Converged
+                    // Wake the relabeled nodes and their neighbors for
+                    // the next round
+                    if (!relabeled.empty()) {
+                        lock_guard<mutex> lock(merge_mutex);
+                        for (int i : relabeled) {
+                            active[i] = 1;
+                            for (int friend_id : graph.friendsAtIndex(i)) {
+                                int f = graph.getNodeIndex(friend_id);
+                                if (f >= 0) active[f] = 1;
+                            }
+                        }
+                    }
+                });
+
+            if (changed.load(memory_order_relaxed) == 0) break; // Converged
         }
 
-        // Group nodes by community
+        // Group nodes by community, mapping indices back to user ids
         map<int, vector<int>> communities_map;
-        for (const auto& [id, label] : labels) {
-            communities_map[label].push_back(id);
+        for (int i = 0; i < n; i++) {
+            int32_t label = labels[i].load(memory_order_relaxed);
+            communities_map[label].push_back(graph.getUserIdAtIndex(i));
         }
 
         // Create result structures
         vector<Community> result;
         int community_idx = 0;
+        long long total_edges = total_friend_edges();
 
         for (auto& [label, members] : communities_map) {
             Community comm;
@@ -161,7 +399,8 @@ public:
             auto [internal, external] = count_community_edges(members);
             comm.edges_within_community = internal;
             comm.edges_to_outside = external;
-            comm.modularity_score = 0.0; // TODO: implement modularity calculation
+            comm.modularity_score =
+                community_modularity(members, internal, total_edges);
 
             result.push_back(comm);
         }
@@ -170,58 +409,71 @@ public:
     }
 
     /**
-     * GREEDY MODULARITY OPTIMIZATION (Louvain-like)
-     * 
-     * More sophisticated algorithm that optimizes modularity.
-     * Better quality than label propagation but slower.
-     * 
-     * Algorithm: Iterative greedy optimization
-     * Time Complexity: O(E * iterations)
-     * Space Complexity: O(V)
-     * 
+     * LOUVAIN MODULARITY OPTIMIZATION
+     *
+     * Better quality than label propagation but slower. Standard
+     * two-phase Louvain on the friend graph: a local-move phase with
+     * incremental modularity gains from cached community degree sums,
+     * then aggregation of each community into a single weighted node,
+     * repeated until a level stops improving. modularity_score carries
+     * each community's contribution in/m - (deg/2m)^2; their sum is the
+     * partition's modularity Q.
+     *
+     * Time Complexity: O(E) per sweep, a handful of sweeps per level
+     * Space Complexity: O(V + E)
+     *
+     * Parameters:
+     *   - max_iterations: cap on aggregation levels (default 10)
+     *
      * Returns: Vector of communities with modularity scores
      */
     vector<Community> detect_greedy_modularity(int max_iterations = 10) const {
-        // Simple implementation: start with connected components
-        unordered_map<int, int> component; // user_id -> component_id
-        int comp_id = 0;
-        const auto& nodes = graph.getNodes();
-
-        // Find connected components using BFS
-        unordered_set<int> visited;
-        for (const auto& [id, node] : nodes) {
-            if (!visited.count(id)) {
-                queue<int> q;
-                q.push(id);
-                visited.insert(id);
-                component[id] = comp_id;
-
-                while (!q.empty()) {
-                    int current = q.front();
-                    q.pop();
-
-                    for (int friend_id : graph.getFriends(current)) {
-                        if (!visited.count(friend_id)) {
-                            visited.insert(friend_id);
-                            component[friend_id] = comp_id;
-                            q.push(friend_id);
-                        }
-                    }
-                }
+        int n = graph.getIndexedNodeCount();
+        if (n == 0) return {};
+
+        // Level 0: the friend graph with unit weights
+        LevelGraph level;
+        level.node_count = n;
+        level.adjacency.assign(n, {});
+        level.self_loops.assign(n, 0.0);
+        for (int i = 0; i < n; i++) {
+            for (int friend_id : graph.friendsAtIndex(i)) {
+                int f = graph.getNodeIndex(friend_id);
+                if (f < 0) continue;
+                level.adjacency[i].emplace_back(f, 1.0);
+                level.total_weight += 1.0;
+            }
+        }
+
+        // assignment: original dense index -> node of the current level
+        vector<int> assignment(n);
+        for (int i = 0; i < n; i++) assignment[i] = i;
 
-                comp_id++;
+        if (level.total_weight > 0.0) {
+            for (int level_index = 0; level_index < max_iterations; level_index++) {
+                vector<int> community;
+                bool moved = local_move_phase(level, community);
+                if (!moved) break;
+
+                int before = level.node_count;
+                level = aggregate_level(level, community);  // renumbers `community`
+                for (int i = 0; i < n; i++) {
+                    assignment[i] = community[assignment[i]];
+                }
+                if (level.node_count == before) break;
             }
         }
 
-        // Group by component
+        // Group original user ids by final community
         map<int, vector<int>> communities_map;
-        for (const auto& [id, comp] : component) {
-            communities_map[comp].push_back(id);
+        for (int i = 0; i < n; i++) {
+            communities_map[assignment[i]].push_back(graph.getUserIdAtIndex(i));
         }
 
         // Create result structures
         vector<Community> result;
         int community_idx = 0;
+        long long total_edges = total_friend_edges();
 
         for (auto& [comp, members] : communities_map) {
             Community comm;
@@ -233,7 +485,8 @@ public:
             auto [internal, external] = count_community_edges(members);
             comm.edges_within_community = internal;
             comm.edges_to_outside = external;
-            comm.modularity_score = 0.0; // TODO: implement modularity calculation
+            comm.modularity_score =
+                community_modularity(members, internal, total_edges);
 
             result.push_back(comm);
         }
@@ -11,6 +11,8 @@
 #include "../algo_utils.hpp"
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <queue>
 #include <algorithm>
 #include <string>
 
@@ -68,6 +70,21 @@ private:
         return similarity * 15.0;
     }
 
+    // Ceiling on everything except the mutual-friends factor: interests
+    // (25) + proximity (20) + community (15). Used to prune candidates
+    // whose mutual score alone cannot reach the current top K.
+    static constexpr double NON_MUTUAL_MAX_SCORE = 25.0 + 20.0 + 15.0;
+
+    // Everything needed to rank a candidate; the display strings are
+    // only built for the K survivors.
+    struct ScoredCandidate {
+        int user_id;
+        double total_score;
+        int mutual_count;
+        int interests_count;
+        double distance_km;
+    };
+
 public:
     explicit FriendRecommender(const SocialGraph& social_graph) 
         : graph(social_graph) {}
@@ -81,62 +98,79 @@ public:
      * - Geographic proximity (20% weight)
      * - Community membership (15% weight)
      * 
-     * Algorithm: 
-     * 1. Find "friends of friends" (excluding already connected)
-     * 2. Score each candidate based on above factors
-     * 3. Return top K sorted by score
-     * 
-     * Time Complexity: O(V * avg_degree^2)
-     * Space Complexity: O(V)
+     * Algorithm:
+     * 1. One pass over friends-of-friends with a flat hash counter:
+     *    every time a candidate shows up in some friend's list they
+     *    share exactly that friend with the target, so the occurrence
+     *    count IS the mutual-friend count (no per-candidate set
+     *    intersection).
+     * 2. Visit candidates in descending mutual count; the other three
+     *    factors are bounded, so once mutual score + that ceiling can't
+     *    beat the current K-th best, every remaining candidate is
+     *    pruned in one break.
+     * 3. Keep a K-sized min-heap (same trick as InfluencerRanker) and
+     *    only build names and reason strings for the final K.
+     *
+     * Time Complexity: O(avg_degree^2 + C log C) for C candidates
+     * Space Complexity: O(C)
      * Returns: Vector of recommendations sorted by score (highest first)
      */
     vector<FriendRecommendation> get_recommendations(
         int target_user_id,
-        int recommendation_count = 10) const 
+        int recommendation_count = 10) const
     {
         const Node* target_user = graph.getNode(target_user_id);
-        if (!target_user) return {};
+        if (!target_user || recommendation_count <= 0) return {};
 
-        auto target_friends = graph.getFriends(target_user_id);
-        map<int, FriendRecommendation> candidate_map;
+        NeighborSpan target_friends = graph.friendsOf(target_user_id);
 
-        // Step 1: Find candidates (friends of friends)
+        // Step 1: candidate generation + mutual counting in one pass
+        unordered_map<int, int> mutual_counts;
         for (int friend_id : target_friends) {
-            auto friend_connections = graph.getFriends(friend_id);
-            for (int candidate_id : friend_connections) {
+            for (int candidate_id : graph.friendsOf(friend_id)) {
                 // Skip if already friend or self
-                if (candidate_id == target_user_id || target_friends.count(candidate_id)) {
+                if (candidate_id == target_user_id ||
+                    target_friends.contains(candidate_id)) {
                     continue;
                 }
-
-                //if not already present then add it in the map
-                if (candidate_map.find(candidate_id) == candidate_map.end()) {
-                    candidate_map[candidate_id] = FriendRecommendation();
-                    candidate_map[candidate_id].recommended_user_id = candidate_id;
-                }
+                mutual_counts[candidate_id]++;
             }
         }
+        if (mutual_counts.empty()) return {};
+
+        // Step 2: score in descending mutual order with pruning
+        vector<pair<int, int>> by_mutual(mutual_counts.begin(),
+                                         mutual_counts.end());
+        sort(by_mutual.begin(), by_mutual.end(),
+             [](const auto& a, const auto& b) {
+                 if (a.second != b.second) return a.second > b.second;
+                 return a.first < b.first;
+             });
 
-        // Step 2: Score each candidate
-        for (auto& [candidate_id, recommendation] : candidate_map) {
-            const Node* candidate = graph.getNode(candidate_id);
-            if (!candidate) continue;
+        auto cmp = [](const ScoredCandidate& a, const ScoredCandidate& b) {
+            return a.total_score > b.total_score;   // min-heap
+        };
+        priority_queue<ScoredCandidate, vector<ScoredCandidate>,
+                       decltype(cmp)> min_heap(cmp);
 
-            recommendation.user_name = candidate->name;
+        for (const auto& [candidate_id, mutual_count] : by_mutual) {
+            double mutual_score = score_mutual_friends(mutual_count);
+
+            // Best case for this (and every later) candidate: full marks
+            // on interests, proximity and community on top of mutual
+            if ((int)min_heap.size() == recommendation_count &&
+                mutual_score + NON_MUTUAL_MAX_SCORE <= min_heap.top().total_score) {
+                break;
+            }
 
-            // Mutual friends count (40% weight)
-            auto mutual = AlgoUtils::set_intersection_of_two(
-                target_friends,
-                graph.getFriends(candidate_id));
-            recommendation.mutual_friends_count = mutual.size();
-            double mutual_score = score_mutual_friends(recommendation.mutual_friends_count);
+            const Node* candidate = graph.getNode(candidate_id);
+            if (!candidate) continue;
 
-            // Common interests (25% weight)
-            auto common_interests = AlgoUtils::find_common_items(
-                target_user->interests,
-                candidate->interests);
-            recommendation.common_interests_count = common_interests.size();
-            double interests_score = score_common_interests(recommendation.common_interests_count);
+            // Common interests (25% weight) - interned ids, so this is
+            // an integer intersection
+            int interests_count = AlgoUtils::count_common_ids(
+                target_user->interest_ids, candidate->interest_ids);
+            double interests_score = score_common_interests(interests_count);
 
             // Geographic proximity (20% weight)
             double distance_km = AlgoUtils::calculate_haversine_distance(
@@ -144,37 +178,48 @@ public:
                 target_user->location.longitude,
                 candidate->location.latitude,
                 candidate->location.longitude);
-            recommendation.geographic_distance_km = distance_km;
             double geo_score = score_geographic_proximity(distance_km);
 
-            // Community similarity (15% weight)
-            recommendation.community_similarity = 0.4; // Placeholder
-            double community_score = score_community_similarity(recommendation.community_similarity);
+            // Community similarity (15% weight) - placeholder value
+            double community_score = score_community_similarity(0.4);
+
+            ScoredCandidate scored;
+            scored.user_id = candidate_id;
+            scored.total_score = mutual_score + interests_score +
+                                 geo_score + community_score;
+            scored.mutual_count = mutual_count;
+            scored.interests_count = interests_count;
+            scored.distance_km = distance_km;
+
+            if ((int)min_heap.size() < recommendation_count) {
+                min_heap.push(scored);
+            } else if (scored.total_score > min_heap.top().total_score) {
+                min_heap.pop();
+                min_heap.push(scored);
+            }
+        }
 
-            // Total score
-            recommendation.total_score = mutual_score + interests_score + 
-                                        geo_score + community_score;
-            recommendation.recommendation_reason = 
-                "Has " + to_string(recommendation.mutual_friends_count) + 
+        // Step 3: materialize the survivors, highest score first
+        vector<FriendRecommendation> result(min_heap.size());
+        for (int i = (int)min_heap.size() - 1; i >= 0; i--) {
+            const ScoredCandidate& scored = min_heap.top();
+            FriendRecommendation& rec = result[i];
+
+            rec.recommended_user_id = scored.user_id;
+            const Node* candidate = graph.getNode(scored.user_id);
+            rec.user_name = candidate ? candidate->name : "";
+            rec.total_score = scored.total_score;
+            rec.mutual_friends_count = scored.mutual_count;
+            rec.common_interests_count = scored.interests_count;
+            rec.geographic_distance_km = scored.distance_km;
+            rec.community_similarity = 0.4; // Placeholder
+            rec.recommendation_reason =
+                "Has " + to_string(scored.mutual_count) +
                 " mutual friends and " +
-                to_string(recommendation.common_interests_count) + 
+                to_string(scored.interests_count) +
                 " shared interests";
-        }
-
-        // Step 3: Sort by score and return top K
-        vector<FriendRecommendation> result;
-        for (auto& [id, rec] : candidate_map) {
-            result.push_back(rec);
-        }
-
-        sort(result.begin(), result.end(),
-             [](const auto& a, const auto& b) { 
-                 return a.total_score > b.total_score; 
-             });
 
-             // for getting set amount of friends suggestion
-        if (result.size() > recommendation_count) {
-            result.resize(recommendation_count);
+            min_heap.pop();
         }
 
         return result;
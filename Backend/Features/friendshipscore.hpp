@@ -46,15 +46,10 @@
      /**
       * Get edge between two nodes (if exists).
       * Returns nullptr if no edge exists.
+      * O(1) via the graph's edge index instead of a full edge scan.
       */
      const Edge* getEdge(int node1, int node2) const {
-         for (const auto& edge : graph.getEdges()) {
-             if ((edge.source == node1 && edge.target == node2) ||
-                 (edge.source == node2 && edge.target == node1)) {
-                 return &edge;
-             }
-         }
-         return nullptr;
+         return graph.findEdge(node1, node2);
      }
      
      /**
@@ -124,10 +119,13 @@
       * Returns average score, or 1.5 (neutral) if no mutual friends.
       */
      double calculateMutualFriendsScore(int node1, int node2) const {
-         auto mutual_friends = AlgoUtils::set_intersection_of_two(
-             graph.getFriends(node1),
-             graph.getFriends(node2));
-         
+         NeighborSpan friends_1 = graph.friendsOf(node1);
+         NeighborSpan friends_2 = graph.friendsOf(node2);
+         vector<int> mutual_friends;
+         AlgoUtils::intersect_sorted(friends_1.begin(), friends_1.end(),
+                                     friends_2.begin(), friends_2.end(),
+                                     mutual_friends);
+
          if (mutual_friends.empty()) return 1.5;  // Neutral
          
          double total_score = 0.0;
@@ -194,22 +192,24 @@
         const Edge* edge = getEdge(node1, node2);
         
         // Check if they are friends - check both directions to be safe
-        set<int> node1Friends = graph.getFriends(node1);
-        set<int> node2Friends = graph.getFriends(node2);
-        bool are_friends = (node1Friends.count(node2) > 0) || (node2Friends.count(node1) > 0);
+        bool are_friends = graph.friendsOf(node1).contains(node2) ||
+                           graph.friendsOf(node2).contains(node1);
         
         // Also check if there's a direct edge with relationship_type == "friend"
-        if (edge && edge->relationship_type == "friend") {
+        if (edge && edge->is_friend_edge()) {
             are_friends = true;
         }
-        
+
         int message_count = edge ? edge->message_count : 0;
-        string established_at = edge ? edge->established_at : "";
+        string established_at = edge ? edge->established_at() : "";
         
-        // Get mutual friends
-        auto mutual_friends = AlgoUtils::set_intersection_of_two(
-            graph.getFriends(node1),
-            graph.getFriends(node2));
+        // Get mutual friends (sorted-merge over the CSR friend rows)
+        NeighborSpan friends_1 = graph.friendsOf(node1);
+        NeighborSpan friends_2 = graph.friendsOf(node2);
+        vector<int> mutual_friends;
+        AlgoUtils::intersect_sorted(friends_1.begin(), friends_1.end(),
+                                    friends_2.begin(), friends_2.end(),
+                                    mutual_friends);
         int mutual_count = mutual_friends.size();
         
         // Calculate mutual friends score (transitive)
@@ -223,10 +223,9 @@
             n1->location.latitude, n1->location.longitude,
             n2->location.latitude, n2->location.longitude);
         
-        // Calculate common interests
-        auto common_interests = AlgoUtils::find_common_items(
-            n1->interests, n2->interests);
-        int interests_count = common_interests.size();
+        // Calculate common interests (interned ids, integer compares)
+        int interests_count = AlgoUtils::count_common_ids(
+            n1->interest_ids, n2->interest_ids);
         
         // ========== SCORE CALCULATION ==========
         // Base score: 1.5 for friends, 2.5 for non-friends
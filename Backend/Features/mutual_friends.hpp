@@ -30,62 +30,84 @@ class MutualFriendsAnalyzer {
 private:
     const SocialGraph& graph;
 
-public:
-    explicit MutualFriendsAnalyzer(const SocialGraph& social_graph) 
-        : graph(social_graph) {}
-
-    /**
-     * MUTUAL FRIENDS ANALYZER
-     * 
-     * Find all common friends between two users.
-     * Shows how connected two users are in the network.
-     * 
-     * Algorithm: intersection of friend sets
-     * Time Complexity: O(min(deg1, deg2))
-     * Space Complexity: O(min(deg1, deg2))
-     * 
-     * Returns: MutualFriendsResult with IDs and similarity ratio
-     */
-    MutualFriendsResult analyze(int user_id_1, int user_id_2) const {
-        const Node* node1 = graph.getNode(user_id_1);
-        const Node* node2 = graph.getNode(user_id_2);
-
-        MutualFriendsResult result;
+    // Fill one result record, intersecting through scratch so a batch
+    // reuses a single allocation. Both friend lists come from the CSR
+    // rows (sorted, contiguous), so the intersection is the sorted-merge
+    // kernel rather than set surgery.
+    void analyzeInto(int user_id_1, int user_id_2,
+                     vector<int>& scratch,
+                     MutualFriendsResult& result) const {
         result.user_id_1 = user_id_1;
         result.user_id_2 = user_id_2;
         result.similarity_ratio = 0.0;
+        result.total_degree_1 = 0;
+        result.total_degree_2 = 0;
+        result.mutual_ids.clear();
 
-        if (!node1 || !node2) {
-            return result;
+        if (!graph.getNode(user_id_1) || !graph.getNode(user_id_2)) {
+            return;
         }
 
-        const auto friends_1 = graph.getFriends(user_id_1);
-        const auto friends_2 = graph.getFriends(user_id_2);
+        NeighborSpan friends_1 = graph.friendsOf(user_id_1);
+        NeighborSpan friends_2 = graph.friendsOf(user_id_2);
 
-        result.total_degree_1 = friends_1.size();
-        result.total_degree_2 = friends_2.size();
+        result.total_degree_1 = (int)friends_1.size();
+        result.total_degree_2 = (int)friends_2.size();
 
         // no friends means no mutual friends
         if (friends_1.empty() || friends_2.empty()) {
-            return result;
+            return;
         }
 
-        // Optimize: Intersect with smaller set first
-        const auto& smaller = friends_1.size() < friends_2.size() ? friends_1 : friends_2;
-        const auto& larger = friends_1.size() <= friends_2.size() ? friends_2 : friends_1;
-
-        // Count intersection without creating intermediate set
-        // Find mutual friends (intersection)
-        for (int friend_id : smaller) {
-            if (larger.count(friend_id)) {
-            result.mutual_ids.push_back(friend_id);
-            }
-        }
-
-        // Calculate Jaccard similarity using the inline function
-        result.similarity_ratio = AlgoUtils::jaccard_similarity(friends_1, friends_2);
+        scratch.clear();
+        AlgoUtils::intersect_sorted(friends_1.begin(), friends_1.end(),
+                                    friends_2.begin(), friends_2.end(),
+                                    scratch);
+        result.mutual_ids = scratch;
+
+        // Jaccard similarity straight from the sizes
+        size_t union_size =
+            friends_1.size() + friends_2.size() - scratch.size();
+        result.similarity_ratio =
+            union_size == 0 ? 0.0 : (double)scratch.size() / union_size;
+    }
 
+public:
+    explicit MutualFriendsAnalyzer(const SocialGraph& social_graph)
+        : graph(social_graph) {}
 
+    /**
+     * MUTUAL FRIENDS ANALYZER
+     *
+     * Find all common friends between two users.
+     * Shows how connected two users are in the network.
+     *
+     * Algorithm: sorted-merge intersection over the CSR friend rows
+     * Time Complexity: O(min(deg1, deg2) * log max(deg1, deg2)) worst,
+     *                  linear merge in the balanced case
+     * Space Complexity: O(intersection)
+     *
+     * Returns: MutualFriendsResult with IDs and similarity ratio
+     */
+    MutualFriendsResult analyze(int user_id_1, int user_id_2) const {
+        MutualFriendsResult result;
+        vector<int> scratch;
+        analyzeInto(user_id_1, user_id_2, scratch, result);
         return result;
     }
+
+    /**
+     * Batch form: analyze one user against many candidates, reusing
+     * the intersection scratch buffer across the whole batch. Results
+     * come back in candidate order.
+     */
+    vector<MutualFriendsResult> analyze_many(
+        int user_id, const vector<int>& candidate_ids) const {
+        vector<MutualFriendsResult> results(candidate_ids.size());
+        vector<int> scratch;
+        for (size_t i = 0; i < candidate_ids.size(); i++) {
+            analyzeInto(user_id, candidate_ids[i], scratch, results[i]);
+        }
+        return results;
+    }
 };
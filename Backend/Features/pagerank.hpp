@@ -8,6 +8,7 @@
 #pragma once
 
 #include "../graph_generator.hpp"
+#include "../thread_pool.hpp"
 #include <map>
 #include <vector>
 
@@ -18,70 +19,91 @@ private:
     const SocialGraph& graph;
 
 public:
-    explicit PageRankCalculator(const SocialGraph& social_graph) 
+    explicit PageRankCalculator(const SocialGraph& social_graph)
         : graph(social_graph) {}
 
     /**
      * PAGERANK CALCULATION
-     * 
+     *
      * Calculate importance score for each user using PageRank algorithm.
      * Models: user importance based on how many important users follow them.
-     * 
-     * Algorithm: Iterative PageRank with damping factor
-     * Time Complexity: O(E * iterations)
-     * Space Complexity: O(V)
-     * 
+     *
+     * Algorithm: Iterative pull-style PageRank over the CSR adjacency.
+     * Ranks live in two flat vector<double> buffers indexed by the dense
+     * node index and swapped between iterations; each node pulls from its
+     * followers (the exact reverse of pushing along `following` edges).
+     * Dangling mass is folded into a single scalar per iteration and the
+     * per-node accumulation is split across the shared thread pool -
+     * pull-style writes are disjoint, so no synchronization is needed.
+     *
+     * Time Complexity: O((V + E) * iterations / threads)
+     * Space Complexity: O(V + E)
+     *
      * Parameters:
      *   - damping_factor: probability of following a link (default 0.85)
      *   - iteration_count: number of iterations for convergence (default 20)
-     * 
+     *
      * Returns: Map of user_id -> importance_score (0.0 to 1.0)
      */
     map<int, double> calculate(
         double damping_factor = 0.85,
-        int iteration_count = 20) const 
+        int iteration_count = 20) const
     {
-        map<int, double> rank;
-        const auto& all_nodes = graph.getNodes();
-        int node_count = all_nodes.size();
+        map<int, double> result;
+        int node_count = graph.getIndexedNodeCount();
+        if (node_count == 0) return result;
 
-        if (node_count == 0) return rank;
+        // One-time translation into dense index space: out-degrees and
+        // the incoming-edge CSR, so the iteration loop never touches the
+        // id -> index hash.
+        vector<int> out_degree(node_count);
+        vector<int> in_offsets(node_count + 1, 0);
+        for (int v = 0; v < node_count; v++) {
+            out_degree[v] = graph.followingAtIndex(v).size();
+            in_offsets[v + 1] = in_offsets[v] + graph.followersAtIndex(v).size();
+        }
 
-        // Initialize: all users start with equal importance
-        double initial_rank = 1.0 / node_count;
-        for (const auto& [id, node] : all_nodes) {
-            rank[id] = initial_rank;
+        vector<int> in_neighbors(in_offsets[node_count]);
+        for (int v = 0; v < node_count; v++) {
+            int write_pos = in_offsets[v];
+            for (int follower_id : graph.followersAtIndex(v)) {
+                in_neighbors[write_pos++] = graph.getNodeIndex(follower_id);
+            }
         }
 
-        // Iteratively update ranks
-        for (int iteration = 0; iteration < iteration_count; iteration++) {
-            map<int, double> new_rank;
+        // Two rank buffers, swapped each iteration
+        vector<double> rank(node_count, 1.0 / node_count);
+        vector<double> new_rank(node_count);
 
-            // base score: each node gets (1-damping) / N
-            for (const auto& [id, node] : all_nodes) {
-                new_rank[id] = (1.0 - damping_factor) / node_count;
+        for (int iteration = 0; iteration < iteration_count; iteration++) {
+            // Fold all dangling mass into one scalar instead of an
+            // O(V) inner loop per dangling node
+            double dangling_mass = 0.0;
+            for (int v = 0; v < node_count; v++) {
+                if (out_degree[v] == 0) dangling_mass += rank[v];
             }
 
-            // Add contribution from outgoing connections (people this user follows)
-            for (const auto& [id, node] : all_nodes) {
-                int out_degree = node.following.size();
-                if (out_degree > 0) {
-                    double contribution = rank[id] / out_degree;
-                    for (int target_id : node.following) {
-                        new_rank[target_id] += damping_factor * contribution;
-                    }
-                } else {
-                    // Dangling node distributes rank evenly
-                    double distributed = damping_factor * rank[id] / node_count;
-                    for (auto& [target_id, _] : new_rank) {
-                        new_rank[target_id] += distributed;
+            double base_rank = (1.0 - damping_factor) / node_count +
+                               damping_factor * dangling_mass / node_count;
+
+            global_thread_pool().parallel_blocks(node_count,
+                [&](int begin, int end) {
+                    for (int v = begin; v < end; v++) {
+                        double incoming = 0.0;
+                        for (int e = in_offsets[v]; e < in_offsets[v + 1]; e++) {
+                            int u = in_neighbors[e];
+                            incoming += rank[u] / out_degree[u];
+                        }
+                        new_rank[v] = base_rank + damping_factor * incoming;
                     }
-                }
-            }
+                });
 
-            rank = new_rank;
+            rank.swap(new_rank);
         }
 
-        return rank;
+        for (int v = 0; v < node_count; v++) {
+            result[graph.getUserIdAtIndex(v)] = rank[v];
+        }
+        return result;
     }
 };
@@ -1,9 +1,10 @@
 #pragma once
 
 #include "../graph_generator.hpp"
+#include "../lru_cache.hpp"
+#include "../traversal.hpp"
 #include <iostream>
 #include <queue>
-#include <unordered_map>
 #include <vector>
 #include <set>
 
@@ -11,6 +12,14 @@
 using namespace std;
 
 
+/**
+ * Accuracy knob for distance queries: Exact runs the (landmark-pruned)
+ * BFS, Approximate answers from the landmark bounds in O(K) when the
+ * index is built - microseconds instead of a frontier expansion.
+ */
+enum class DistanceAccuracy { Exact, Approximate };
+
+
 struct PathFindResult {
     bool path_exists;           // Whether connection found
     vector<int> path_node_ids;  // IDs of users in the path (source to target)
@@ -29,9 +38,101 @@ struct PathFindResult {
 
 class OptimizedDistanceCalculator {
 private:
+    // The api_server calls into one calculator from many worker threads,
+    // and the old unordered_map cache both grew without bound and raced.
+    // Bounded sharded LRU: per-shard locks keep concurrent lookups from
+    // serializing, and eviction caps memory. A PathFindResult carries
+    // the distance too (path_length, -1 when unreachable), so one cache
+    // serves both find_path and calculate_shortest_distance.
+    static constexpr size_t PATH_CACHE_CAPACITY = 100000;
+
     const SocialGraph& graph;
-    unordered_map<long long, int> cache;
-    unordered_map<long long, PathFindResult> result_cache;
+    mutable ShardedLRUCache<long long, PathFindResult> result_cache;
+
+    // ===== LANDMARK (ALT-STYLE) DISTANCE INDEX =====
+    // BFS distance vectors from K high-degree hub nodes, forward along
+    // `following` and backward along `followers`. Triangle inequality
+    // then gives O(K) lower/upper distance bounds per pair: upper bounds
+    // answer approximate queries instantly, and exact searches cap
+    // their expansion depth at the upper bound.
+    bool landmarks_built = false;
+    vector<int> landmark_indices;                 // dense node indices
+    vector<vector<int>> landmark_forward_dist;    // landmark -> all nodes
+    vector<vector<int>> landmark_backward_dist;   // all nodes -> landmark
+
+    // Graph structure version the cache and landmarks were built
+    // against; a mismatch means applyEdgeDelta/updateGraph ran since.
+    uint64_t indexed_version;
+
+    // Lazily drop stale state: clear the result cache and rebuild the
+    // landmark index once after a graph change, paid for by the first
+    // query that follows instead of eagerly on every delta.
+    void invalidate_if_stale() {
+        uint64_t current = graph.getStructureVersion();
+        if (current == indexed_version) return;
+        result_cache.clear();
+        indexed_version = current;
+        if (landmarks_built) {
+            build_landmark_index((int)landmark_indices.size());
+        }
+    }
+
+    // BFS over the CSR arrays filling dist (indexed by dense index).
+    void bfs_fill(int source_index, bool forward, vector<int>& dist) const {
+        dist.assign(graph.getIndexedNodeCount(), -1);
+        if (source_index < 0) return;
+
+        queue<int> q;
+        dist[source_index] = 0;
+        q.push(source_index);
+        while (!q.empty()) {
+            int u = q.front();
+            q.pop();
+            NeighborSpan neighbors = forward ? graph.followingAtIndex(u)
+                                             : graph.followersAtIndex(u);
+            for (int neighbor_id : neighbors) {
+                int v = graph.getNodeIndex(neighbor_id);
+                if (v >= 0 && dist[v] < 0) {
+                    dist[v] = dist[u] + 1;
+                    q.push(v);
+                }
+            }
+        }
+    }
+
+    /**
+     * O(K) distance bounds for a pair from the landmark vectors.
+     * Returns {lower, upper}; upper is -1 when no landmark connects the
+     * pair (no estimate available).
+     */
+    pair<int, int> landmark_bounds(int source_id, int target_id) const {
+        int s = graph.getNodeIndex(source_id);
+        int t = graph.getNodeIndex(target_id);
+        if (!landmarks_built || s < 0 || t < 0) return {0, -1};
+
+        int lower = 0;
+        int upper = -1;
+        for (size_t l = 0; l < landmark_indices.size(); l++) {
+            int l_to_s = landmark_forward_dist[l][s];
+            int l_to_t = landmark_forward_dist[l][t];
+            int s_to_l = landmark_backward_dist[l][s];
+            int t_to_l = landmark_backward_dist[l][t];
+
+            // Upper: route through the landmark
+            if (s_to_l >= 0 && l_to_t >= 0) {
+                int through = s_to_l + l_to_t;
+                if (upper < 0 || through < upper) upper = through;
+            }
+            // Lower: triangle inequality in both directions
+            if (l_to_s >= 0 && l_to_t >= 0) {
+                lower = max(lower, l_to_t - l_to_s);
+            }
+            if (s_to_l >= 0 && t_to_l >= 0) {
+                lower = max(lower, s_to_l - t_to_l);
+            }
+        }
+        return {lower, upper};
+    }
 
 
     // FIX #5: Safer encoding that avoids overflow
@@ -60,95 +161,94 @@ private:
     }
 
 
-    // Helper to reconstruct path from meeting node
-    vector<int> reconstruct_path(int meeting_node, 
-                                 const unordered_map<int, int>& parent_src,
-                                 const unordered_map<int, int>& parent_tgt) const {
+    // Helper to reconstruct path from meeting node. Works in dense
+    // index space (the parent chains live in the BFS scratch) and
+    // translates back to user ids for the result.
+    vector<int> reconstruct_path(int meeting_index,
+                                 const BFSScratch& src_side,
+                                 const BFSScratch& tgt_side) const {
         // Path from source to meeting node
-        vector<int> path_forward;
-        int current = meeting_node;
+        vector<int> full_path;
+        int current = meeting_index;
         while (current != -1) {
-            path_forward.push_back(current);
-            auto it = parent_src.find(current);
-            if (it != parent_src.end()) {
-                current = it->second;
-            } else {
-                break;
-            }
+            full_path.push_back(graph.getUserIdAtIndex(current));
+            current = src_side.parent(current);
         }
-        reverse(path_forward.begin(), path_forward.end());
+        reverse(full_path.begin(), full_path.end());
 
-        // Path from meeting node to target
-        vector<int> path_backward;
-        current = meeting_node;
+        // Continue from meeting node to target (skip the meeting node
+        // itself - it is already on the forward half)
+        current = tgt_side.parent(meeting_index);
         while (current != -1) {
-            path_backward.push_back(current);
-            auto it = parent_tgt.find(current);
-            if (it != parent_tgt.end()) {
-                current = it->second;
-            } else {
-                break;
-            }
-        }
-
-        // Combine paths (avoid duplicating meeting node)
-        vector<int> full_path = path_forward;
-        for (size_t i = 1; i < path_backward.size(); i++) {
-            full_path.push_back(path_backward[i]);
+            full_path.push_back(graph.getUserIdAtIndex(current));
+            current = tgt_side.parent(current);
         }
 
         return full_path;
     }
 
 
-    // Core bidirectional BFS with path reconstruction
-    PathFindResult bidirectional_bfs(int source_id, int target_id) const {
+    // Core bidirectional BFS with path reconstruction. max_depth caps
+    // each frontier: when the landmark index already proves a path of
+    // that length exists, nodes further out cannot be on a shortest
+    // path and are not expanded.
+    PathFindResult bidirectional_bfs(int source_id, int target_id,
+                                     int max_depth = -1) const {
         if (source_id == target_id) {
             return create_success_result(vector<int>{source_id});
         }
-        
-        unordered_map<int, int> dist_src;
-        unordered_map<int, int> dist_tgt;
-        unordered_map<int, int> parent_src;
-        unordered_map<int, int> parent_tgt;
-        queue<int> q_src, q_tgt;
-        
-        q_src.push(source_id);
-        q_tgt.push(target_id);
-        dist_src[source_id] = 0;
-        dist_tgt[target_id] = 0;
-        parent_src[source_id] = -1;
-        parent_tgt[target_id] = -1;
-
-        int meeting_node = -1;
+
+        int source_index = graph.getNodeIndex(source_id);
+        int target_index = graph.getNodeIndex(target_id);
+        if (source_index < 0 || target_index < 0) {
+            return create_failure_result();
+        }
+
+        // Dense-index scratch replaces the per-call unordered_maps: one
+        // bit probe per neighbor instead of a hash lookup, and the
+        // allocations survive across calls on the same thread.
+        static thread_local BFSScratch src_side;
+        static thread_local BFSScratch tgt_side;
+        int node_count = graph.getIndexedNodeCount();
+        src_side.reset(node_count);
+        tgt_side.reset(node_count);
+
+        src_side.mark(source_index, 0, -1);
+        src_side.enqueue(source_index);
+        tgt_side.mark(target_index, 0, -1);
+        tgt_side.enqueue(target_index);
+
+        int meeting_index = -1;
         bool found = false;
 
-        while ((!q_src.empty() || !q_tgt.empty()) && !found) {
+        while ((src_side.pending() || tgt_side.pending()) && !found) {
             // Forward direction - process one level
-            if (!q_src.empty()) {
-                int level_size = q_src.size();
-                for (int i = 0; i < level_size && !found; i++) {
-                    int u = q_src.front();
-                    q_src.pop();
-                    
-                    set<int> outgoing = graph.getFollowing(u);
-                    for (int v : outgoing) {
+            {
+                size_t level_size = src_side.pending();
+                for (size_t i = 0; i < level_size && !found; i++) {
+                    int u = src_side.pop();
+
+                    for (int neighbor_id : graph.followingAtIndex(u)) {
+                        int v = graph.getNodeIndex(neighbor_id);
+                        if (v < 0) continue;
+
                         // Check if reached from other direction
-                        if (dist_tgt.count(v)) {
-                            if (!parent_src.count(v)) {
-                                parent_src[v] = u;
-                                dist_src[v] = dist_src[u] + 1;
+                        if (tgt_side.seen(v)) {
+                            if (!src_side.seen(v)) {
+                                src_side.mark(v, src_side.dist(u) + 1, u);
                             }
-                            meeting_node = v;
+                            meeting_index = v;
                             found = true;
                             break;
                         }
-                        
+
                         // Mark as visited
-                        if (!dist_src.count(v)) {
-                            dist_src[v] = dist_src[u] + 1;
-                            parent_src[v] = u;
-                            q_src.push(v);
+                        if (!src_side.seen(v)) {
+                            int depth = src_side.dist(u) + 1;
+                            src_side.mark(v, depth, u);
+                            if (max_depth < 0 || depth < max_depth) {
+                                src_side.enqueue(v);
+                            }
                         }
                     }
                 }
@@ -157,84 +257,92 @@ private:
             if (found) break;
 
             // Backward direction - process one level
-            if (!q_tgt.empty()) {
-                int level_size = q_tgt.size();
-                for (int i = 0; i < level_size && !found; i++) {
-                    int u = q_tgt.front();
-                    q_tgt.pop();
-                    
-                    set<int> outgoing = graph.getFollowing(u);
-                    for (int v : outgoing) {
+            {
+                size_t level_size = tgt_side.pending();
+                for (size_t i = 0; i < level_size && !found; i++) {
+                    int u = tgt_side.pop();
+
+                    for (int neighbor_id : graph.followingAtIndex(u)) {
+                        int v = graph.getNodeIndex(neighbor_id);
+                        if (v < 0) continue;
+
                         // Check if reached from other direction
-                        if (dist_src.count(v)) {
-                            if (!parent_tgt.count(v)) {
-                                parent_tgt[v] = u;
-                                dist_tgt[v] = dist_tgt[u] + 1;
+                        if (src_side.seen(v)) {
+                            if (!tgt_side.seen(v)) {
+                                tgt_side.mark(v, tgt_side.dist(u) + 1, u);
                             }
-                            meeting_node = v;
+                            meeting_index = v;
                             found = true;
                             break;
                         }
-                        
+
                         // Mark as visited
-                        if (!dist_tgt.count(v)) {
-                            dist_tgt[v] = dist_tgt[u] + 1;
-                            parent_tgt[v] = u;
-                            q_tgt.push(v);
+                        if (!tgt_side.seen(v)) {
+                            int depth = tgt_side.dist(u) + 1;
+                            tgt_side.mark(v, depth, u);
+                            if (max_depth < 0 || depth < max_depth) {
+                                tgt_side.enqueue(v);
+                            }
                         }
                     }
                 }
             }
         }
-        
+
         // No path found
         if (!found) {
             return create_failure_result();
         }
 
         // Reconstruct and return path
-        vector<int> full_path = reconstruct_path(meeting_node, parent_src, parent_tgt);
+        vector<int> full_path = reconstruct_path(meeting_index, src_side, tgt_side);
         return create_success_result(full_path);
     }
 
 
     // Simple unidirectional BFS as fallback (guaranteed to find target if it exists)
-    PathFindResult simple_bfs(int source_id, int target_id) const {
+    PathFindResult simple_bfs(int source_id, int target_id,
+                              int max_depth = -1) const {
         if (source_id == target_id) {
             return create_success_result(vector<int>{source_id});
         }
 
-        unordered_map<int, int> dist;
-        unordered_map<int, int> parent;
-        queue<int> q;
+        int source_index = graph.getNodeIndex(source_id);
+        int target_index = graph.getNodeIndex(target_id);
+        if (source_index < 0 || target_index < 0) {
+            return create_failure_result();
+        }
 
-        q.push(source_id);
-        dist[source_id] = 0;
-        parent[source_id] = -1;
+        static thread_local BFSScratch scratch;
+        scratch.reset(graph.getIndexedNodeCount());
+        scratch.mark(source_index, 0, -1);
+        scratch.enqueue(source_index);
 
-        while (!q.empty()) {
-            int u = q.front();
-            q.pop();
+        while (scratch.pending()) {
+            int u = scratch.pop();
 
             // Found target
-            if (u == target_id) {
-                // Reconstruct path
+            if (u == target_index) {
+                // Reconstruct path, translating indices back to user ids
                 vector<int> path;
-                int current = target_id;
+                int current = target_index;
                 while (current != -1) {
-                    path.push_back(current);
-                    current = parent[current];
+                    path.push_back(graph.getUserIdAtIndex(current));
+                    current = scratch.parent(current);
                 }
                 reverse(path.begin(), path.end());
                 return create_success_result(path);
             }
 
-            set<int> outgoing = graph.getFollowing(u);
-            for (int v : outgoing) {
-                if (!dist.count(v)) {
-                    dist[v] = dist[u] + 1;
-                    parent[v] = u;
-                    q.push(v);
+            for (int neighbor_id : graph.followingAtIndex(u)) {
+                int v = graph.getNodeIndex(neighbor_id);
+                if (v >= 0 && !scratch.seen(v)) {
+                    int depth = scratch.dist(u) + 1;
+                    scratch.mark(v, depth, u);
+                    // The target itself may sit exactly on the depth cap
+                    if (max_depth < 0 || depth < max_depth || v == target_index) {
+                        scratch.enqueue(v);
+                    }
                 }
             }
         }
@@ -244,94 +352,188 @@ private:
     }
 
     PathFindResult compute_path_internal(int source_id, int target_id) const {
-        // First check if they are directly connected (friends or following)
-        set<int> sourceFriends = graph.getFriends(source_id);
-        set<int> sourceFollowing = graph.getFollowing(source_id);
-        
+        // First check if they are directly connected (friends or following).
+        // NeighborSpan::contains is a binary search over the CSR row, so
+        // these checks no longer copy whole neighbor sets.
+
         // Check if target is a friend (mutual connection)
-        if (sourceFriends.count(target_id) > 0) {
+        if (graph.friendsOf(source_id).contains(target_id)) {
             vector<int> directPath = {source_id, target_id};
             return create_success_result(directPath);
         }
-        
+
         // Check if source follows target (direct edge)
-        if (sourceFollowing.count(target_id) > 0) {
+        if (graph.followingOf(source_id).contains(target_id)) {
             vector<int> directPath = {source_id, target_id};
             return create_success_result(directPath);
         }
-        
+
         // Check if target follows source (reverse direction)
-        set<int> targetFollowing = graph.getFollowing(target_id);
-        if (targetFollowing.count(source_id) > 0) {
+        if (graph.followingOf(target_id).contains(source_id)) {
             vector<int> directPath = {source_id, target_id};
             return create_success_result(directPath);
         }
         
-        // If not directly connected, use BFS
-        PathFindResult result = bidirectional_bfs(source_id, target_id);
+        // If not directly connected, use BFS. When the landmark index is
+        // built, its upper bound caps how deep either search can go.
+        int max_depth = -1;
+        if (landmarks_built) {
+            max_depth = landmark_bounds(source_id, target_id).second;
+        }
+
+        PathFindResult result = bidirectional_bfs(source_id, target_id, max_depth);
         if (!result.path_exists) {
-            result = simple_bfs(source_id, target_id);
+            result = simple_bfs(source_id, target_id, max_depth);
         }
         return result;
     }
 
 
 public:
-    OptimizedDistanceCalculator(const SocialGraph& g) : graph(g) {}
+    OptimizedDistanceCalculator(const SocialGraph& g)
+        : graph(g), result_cache(PATH_CACHE_CAPACITY),
+          indexed_version(g.getStructureVersion()) {}
+
+
+    /**
+     * Build the landmark index: BFS distance vectors (forward and
+     * backward) from the landmark_count highest-degree users. One-time
+     * O(K * (V + E)) cost at graph load; afterwards every pair query
+     * gets O(K) distance bounds for pruning or instant estimates.
+     */
+    void build_landmark_index(int landmark_count = 16) {
+        int node_count = graph.getIndexedNodeCount();
+        landmark_count = min(landmark_count, node_count);
+        if (landmark_count <= 0) return;
+
+        // Pick the best-connected hubs by friend count
+        vector<int> by_degree(node_count);
+        for (int i = 0; i < node_count; i++) by_degree[i] = i;
+        sort(by_degree.begin(), by_degree.end(), [this](int a, int b) {
+            return graph.getFriendCount(graph.getUserIdAtIndex(a)) >
+                   graph.getFriendCount(graph.getUserIdAtIndex(b));
+        });
+
+        landmark_indices.assign(by_degree.begin(),
+                                by_degree.begin() + landmark_count);
+        landmark_forward_dist.assign(landmark_count, {});
+        landmark_backward_dist.assign(landmark_count, {});
+        for (int l = 0; l < landmark_count; l++) {
+            bfs_fill(landmark_indices[l], true, landmark_forward_dist[l]);
+            bfs_fill(landmark_indices[l], false, landmark_backward_dist[l]);
+        }
+        landmarks_built = true;
+    }
+
+
+    bool has_landmark_index() const {
+        return landmarks_built;
+    }
+
+
+    /**
+     * O(K) approximate distance from the landmark index: the tightest
+     * upper bound over all landmarks (exact whenever a shortest path
+     * passes through one). Returns -1 when no landmark connects the
+     * pair or the index is not built.
+     */
+    int estimate_distance(int source_id, int target_id) {
+        invalidate_if_stale();
+        if (source_id == target_id) return 0;
+        if (graph.friendsOf(source_id).contains(target_id) ||
+            graph.followingOf(source_id).contains(target_id)) {
+            return 1;
+        }
+        return landmark_bounds(source_id, target_id).second;
+    }
 
 
     // Main function: Bidirectional BFS + Caching (returns PathFindResult)
     PathFindResult find_path(int source_id, int target_id) {
-        // Normalize for cache
-        int norm_src = source_id;
-        int norm_tgt = target_id;
-        if (norm_src > norm_tgt) swap(norm_src, norm_tgt);
-        long long key = encode_pair(norm_src, norm_tgt);
-
+        invalidate_if_stale();
+        long long key = encode_pair(source_id, target_id);
 
         // Check cache first
-        if (result_cache.count(key)) {
-            return result_cache[key];
+        PathFindResult result;
+        if (result_cache.get(key, result)) {
+            return result;
         }
 
-
         // Use bidirectional BFS with fallback to guarantee correctness
-        PathFindResult result = compute_path_internal(source_id, target_id);
-        
+        result = compute_path_internal(source_id, target_id);
+
         // Store in cache
-        result_cache[key] = result;
-        if (result.path_exists) {
-            cache[key] = result.path_length;
-        }
+        result_cache.put(key, result);
         return result;
     }
 
 
     // Legacy function: Get shortest distance only (for backward compatibility)
-    int calculate_shortest_distance(int source_id, int target_id) {
+    // Pass DistanceAccuracy::Approximate to answer from the landmark
+    // index in O(K) instead of searching.
+    int calculate_shortest_distance(int source_id, int target_id,
+                                    DistanceAccuracy accuracy = DistanceAccuracy::Exact) {
+        invalidate_if_stale();
         if (source_id == target_id) return 0;
-        
-        // Normalize for cache
-        int norm_src = source_id;
-        int norm_tgt = target_id;
-        if (norm_src > norm_tgt) swap(norm_src, norm_tgt);
-        long long key = encode_pair(norm_src, norm_tgt);
 
+        if (accuracy == DistanceAccuracy::Approximate && landmarks_built) {
+            return estimate_distance(source_id, target_id);
+        }
+
+        long long key = encode_pair(source_id, target_id);
 
         // Check cache first
-        if (cache.count(key)) {
-            return cache[key];
+        PathFindResult result;
+        if (result_cache.get(key, result)) {
+            return result.path_length;
         }
 
+        result = compute_path_internal(source_id, target_id);
 
-        PathFindResult result = compute_path_internal(source_id, target_id);
-        
-        result_cache[key] = result;
-        cache[key] = result.path_exists ? result.path_length : -1;
+        result_cache.put(key, result);
         return result.path_length;
     }
 
 
+    /**
+     * SINGLE-SOURCE DISTANCE ENGINE
+     *
+     * One BFS from source_id over the `following` relation, filling a
+     * dense distance array indexed by the graph's node index
+     * (-1 = unreachable, 0 = the source itself).
+     *
+     * This answers in one O(V + E) pass what V separate pair queries
+     * used to: closeness centrality derives both the distance sum and
+     * the reachable count from the returned array.
+     */
+    vector<int> compute_distances_from(int source_id) const {
+        int node_count = graph.getIndexedNodeCount();
+        vector<int> distances(node_count, -1);
+
+        int source_index = graph.getNodeIndex(source_id);
+        if (source_index < 0) return distances;
+
+        queue<int> q;
+        distances[source_index] = 0;
+        q.push(source_index);
+
+        while (!q.empty()) {
+            int u = q.front();
+            q.pop();
+
+            for (int neighbor_id : graph.followingAtIndex(u)) {
+                int v = graph.getNodeIndex(neighbor_id);
+                if (v >= 0 && distances[v] < 0) {
+                    distances[v] = distances[u] + 1;
+                    q.push(v);
+                }
+            }
+        }
+
+        return distances;
+    }
+
+
     // Batch find paths
     vector<PathFindResult> find_paths_batch(int source_id, const vector<int>& target_ids) {
         vector<PathFindResult> results;
@@ -354,21 +556,62 @@ public:
     }
 
 
+    /**
+     * WARM-START SUPPORT
+     *
+     * Export every cached path result so the api_server can persist
+     * them across restarts, and re-import a saved set after a reload.
+     * Entries come back least-recent first, and import replays them
+     * through put(), so capacity limits and recency ordering behave
+     * exactly as if the original queries had just run.
+     */
+    vector<pair<long long, PathFindResult>> export_cache_entries() const {
+        vector<pair<long long, PathFindResult>> entries;
+        entries.reserve(result_cache.size());
+        result_cache.forEach(
+            [&](const long long& key, const PathFindResult& result) {
+                entries.emplace_back(key, result);
+            });
+        return entries;
+    }
+
+    void import_cache_entries(
+        const vector<pair<long long, PathFindResult>>& entries) {
+        invalidate_if_stale();
+        for (const auto& [key, result] : entries) {
+            result_cache.put(key, result);
+        }
+    }
+
+
     // Cache management
     int get_cache_size() const {
         return result_cache.size();
     }
 
 
+    // Raw counters for external instrumentation (/api/stats).
+    ShardedLRUCache<long long, PathFindResult>::Stats cache_stats() const {
+        return result_cache.stats();
+    }
+
+
     void clear_cache() {
-        cache.clear();
         result_cache.clear();
     }
 
 
     void print_cache_stats() const {
+        auto stats = result_cache.stats();
+        uint64_t lookups = stats.hits + stats.misses;
         cout << "\n=== Cache Statistics ===" << endl;
-        cout << "Cached queries: " << result_cache.size() << endl;
-        cout << "Memory used: ~" << (result_cache.size() * 64) / 1024 << " KB" << endl;
+        cout << "Cached queries: " << stats.entries
+             << " (capacity " << PATH_CACHE_CAPACITY << ")" << endl;
+        cout << "Hits: " << stats.hits << ", Misses: " << stats.misses
+             << ", Evictions: " << stats.evictions << endl;
+        if (lookups > 0) {
+            cout << "Hit rate: " << (100.0 * stats.hits / lookups) << "%" << endl;
+        }
+        cout << "Memory used: ~" << (stats.entries * 64) / 1024 << " KB" << endl;
     }
 };
@@ -2,181 +2,235 @@
 /*
  * USER SEARCH INDEX (AUTOCOMPLETE)
  * =================================
- * Efficient prefix-based user search using Trie data structure.
+ * Efficient prefix-based user search using a path-compressed radix trie.
+ * All nodes live in one arena vector with child links as indices - no
+ * per-character heap allocations, no pointer chasing, trivially freed.
+ *
+ * Ranking trick: the (lowercased) names are sorted once at build time,
+ * so every trie node's subtree is a contiguous range [lo, hi) of that
+ * sorted order. A node's "precomputed top-K" is therefore just the
+ * first K entries of its range - search walks the prefix, copies K ids,
+ * done. Any limit is supported in O(prefix + limit) with no duplicate
+ * filtering or re-sorting.
  */
 
 #pragma once
 
 #include "../graph_generator.hpp"
 #include <vector>
-#include <unordered_map>
 #include <string>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 
 using namespace std;
 
 /**
  * User Search Index for autocomplete functionality
- * Uses Trie data structure for efficient prefix matching
+ * Uses an arena-allocated radix trie for efficient prefix matching
  */
 class UserSearchIndex {
 private:
-    struct TrieNode {
-        unordered_map<char, TrieNode*> children;
-        vector<int> user_ids;  // User IDs matching this prefix
-        
-        ~TrieNode() {
-            for (auto& pair : children) {
-                delete pair.second;
-            }
-        }
+    // One arena slot. edge_label is the compressed path fragment leading
+    // into this node; [range_lo, range_hi) is this subtree's slice of
+    // the name-sorted user list. Children form a singly linked list in
+    // sorted (= ranked) order.
+    struct RadixNode {
+        string edge_label;
+        int range_lo = 0;
+        int range_hi = 0;
+        int first_child = -1;
+        int next_sibling = -1;
     };
-    
-    TrieNode* root;
+
+    vector<RadixNode> arena;       // arena[0] is the root
+    vector<string> sorted_names;   // lowercased names, ascending
+    vector<int> ranked_ids;        // user ids in sorted-name order
     const SocialGraph* graph;
     bool isBuilt;
+    uint64_t indexedVersion;
 
-    void resetTrie() {
-        delete root;
-        root = new TrieNode();
+    // Rebuild lazily when the graph has changed since the trie was
+    // built (delta updates can add or rename users). Checked at search
+    // entry, so a refresh only pays for itself when someone searches.
+    void refreshIfStale() {
+        if (isBuilt && graph &&
+            graph->getStructureVersion() != indexedVersion) {
+            buildIndex(*graph);
+        }
     }
-    
+
     // Helper to convert string to lowercase
     string toLower(const string& str) const {
         string result = str;
         transform(result.begin(), result.end(), result.begin(), ::tolower);
         return result;
     }
-    
-    // Insert a user name into the trie
-    void insert(const string& name, int user_id) {
-        string lowerName = toLower(name);
-        TrieNode* current = root;
-        
-        for (char c : lowerName) {
-            if (current->children.find(c) == current->children.end()) {
-                current->children[c] = new TrieNode();
-            }
-            current = current->children[c];
-            
-            // Store user_id at each node (allows prefix matching)
-            // Limit to avoid storing too many IDs at root
-            if (current->user_ids.size() < 100) {
-                current->user_ids.push_back(user_id);
-            }
+
+    // Longest common prefix length of two names starting at depth.
+    static size_t commonPrefixFrom(const string& a, const string& b, size_t depth) {
+        size_t len = 0;
+        size_t max_len = min(a.size(), b.size()) - depth;
+        while (len < max_len && a[depth + len] == b[depth + len]) {
+            len++;
         }
+        return len;
     }
-    
-    // Get all user IDs from a trie node and its children
-    void getAllUserIds(TrieNode* node, vector<int>& result, int limit) const {
-        if (!node || result.size() >= limit) return;
-        
-        // Add user IDs from current node
-        for (int user_id : node->user_ids) {
-            if (result.size() >= limit) break;
-            // Avoid duplicates
-            if (find(result.begin(), result.end(), user_id) == result.end()) {
-                result.push_back(user_id);
+
+    /**
+     * Build the subtree for sorted_names[lo, hi) at the given depth and
+     * return its arena index. Children are one run per distinct next
+     * character; each child's edge label is the longest common prefix of
+     * its run (the names are sorted, so that is the LCP of the run's
+     * first and last entries). Names ending exactly at depth need no
+     * child - they are covered by the node's range.
+     */
+    int buildSubtree(int lo, int hi, size_t depth) {
+        int node_index = (int)arena.size();
+        arena.emplace_back();
+        arena[node_index].range_lo = lo;
+        arena[node_index].range_hi = hi;
+
+        int i = lo;
+        while (i < hi && sorted_names[i].size() == depth) i++;
+
+        int previous_child = -1;
+        while (i < hi) {
+            char next_char = sorted_names[i][depth];
+            int j = i + 1;
+            while (j < hi && sorted_names[j][depth] == next_char) j++;
+
+            size_t lcp = commonPrefixFrom(sorted_names[i],
+                                          sorted_names[j - 1], depth);
+            string label = sorted_names[i].substr(depth, lcp);
+            int child = buildSubtree(i, j, depth + lcp);
+            arena[child].edge_label = move(label);
+
+            if (previous_child < 0) {
+                arena[node_index].first_child = child;
+            } else {
+                arena[previous_child].next_sibling = child;
             }
+            previous_child = child;
+            i = j;
         }
-        
-        // Recursively search children
-        for (const auto& pair : node->children) {
-            if (result.size() >= limit) break;
-            getAllUserIds(pair.second, result, limit);
+        return node_index;
+    }
+
+    /**
+     * Walk the prefix through the compressed edges. Returns the arena
+     * index of the node whose subtree holds every match, or -1 if the
+     * prefix matches nothing. A prefix is allowed to end mid-edge.
+     */
+    int findPrefixNode(const string& prefix) const {
+        int node = 0;
+        size_t consumed = 0;
+        while (consumed < prefix.size()) {
+            int child = arena[node].first_child;
+            while (child >= 0 &&
+                   arena[child].edge_label[0] != prefix[consumed]) {
+                child = arena[child].next_sibling;
+            }
+            if (child < 0) return -1;
+
+            const string& label = arena[child].edge_label;
+            size_t remaining = prefix.size() - consumed;
+            size_t compare_len = min(label.size(), remaining);
+            if (prefix.compare(consumed, compare_len, label, 0, compare_len) != 0) {
+                return -1;
+            }
+            consumed += compare_len;
+            node = child;
         }
+        return node;
     }
 
 public:
-    UserSearchIndex() : root(new TrieNode()), graph(nullptr), isBuilt(false) {}
-    
-    ~UserSearchIndex() {
-        delete root;
-    }
-    
+    UserSearchIndex() : graph(nullptr), isBuilt(false), indexedVersion(0) {}
+
     // Build the search index from the graph
     void buildIndex(const SocialGraph& graph) {
         this->graph = &graph;
-        resetTrie();
         isBuilt = false;
-        
+        arena.clear();
+        sorted_names.clear();
+        ranked_ids.clear();
+
         const auto& nodes = graph.getNodes();
+        vector<pair<string, int>> entries;
+        entries.reserve(nodes.size());
         for (const auto& pair : nodes) {
-            const Node& node = pair.second;
-            insert(node.name, node.user_id);
+            entries.emplace_back(toLower(pair.second.name), pair.first);
+        }
+        sort(entries.begin(), entries.end());
+
+        sorted_names.reserve(entries.size());
+        ranked_ids.reserve(entries.size());
+        for (auto& entry : entries) {
+            sorted_names.push_back(move(entry.first));
+            ranked_ids.push_back(entry.second);
         }
-        
+
+        buildSubtree(0, (int)sorted_names.size(), 0);
+
+        indexedVersion = graph.getStructureVersion();
         isBuilt = true;
     }
-    
+
     /**
      * Search for users matching the given prefix
-     * 
+     *
      * @param prefix Search query (prefix)
      * @param limit Maximum number of results to return (default: 10)
-     * @return Vector of user IDs matching the prefix, sorted by relevance
+     * @return Vector of user IDs matching the prefix, sorted by name
      */
-    vector<int> search(const string& prefix, int limit = 10) const {
+    vector<int> search(const string& prefix, int limit = 10) {
+        refreshIfStale();
+
         vector<int> results;
-        
-        if (!isBuilt || prefix.empty()) {
+
+        if (!isBuilt || prefix.empty() || limit <= 0) {
             return results;
         }
-        
-        string lowerPrefix = toLower(prefix);
-        TrieNode* current = root;
-        
-        // Navigate to the node representing the prefix
-        for (char c : lowerPrefix) {
-            if (current->children.find(c) == current->children.end()) {
-                return results;  // No matches
-            }
-            current = current->children[c];
-        }
-        
-        // Collect all user IDs from this node and its children
-        getAllUserIds(current, results, limit);
-        
-        // Sort by name for consistent ordering
-        sort(results.begin(), results.end(), [this](int a, int b) {
-            const Node* nodeA = graph->getNode(a);
-            const Node* nodeB = graph->getNode(b);
-            if (!nodeA || !nodeB) return false;
-            return toLower(nodeA->name) < toLower(nodeB->name);
-        });
-        
+
+        int node = findPrefixNode(toLower(prefix));
+        if (node < 0) return results;
+
+        // The subtree's matches are pre-ranked: copy the first K
+        int lo = arena[node].range_lo;
+        int hi = min(arena[node].range_hi, lo + limit);
+        results.assign(ranked_ids.begin() + lo, ranked_ids.begin() + hi);
         return results;
     }
-    
+
     /**
      * Search and return user information
-     * 
+     *
      * @param prefix Search query
      * @param limit Maximum results
      * @return Vector of pairs (user_id, name) sorted by relevance
      */
-    vector<pair<int, string>> searchWithNames(const string& prefix, int limit = 10) const {
+    vector<pair<int, string>> searchWithNames(const string& prefix, int limit = 10) {
         vector<int> user_ids = search(prefix, limit);
         vector<pair<int, string>> results;
-        
+
         for (int user_id : user_ids) {
             const Node* node = graph->getNode(user_id);
             if (node) {
                 results.push_back({user_id, node->name});
             }
         }
-        
+
         return results;
     }
-    
+
     /**
      * Check if the index is built and ready
      */
     bool isReady() const {
         return isBuilt;
     }
-    
+
     /**
      * Get total number of indexed users
      */
@@ -185,4 +239,3 @@ public:
         return graph->getNodeCount();
     }
 };
-
@@ -13,6 +13,7 @@
 #include <string>
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 using namespace std;
 
@@ -88,6 +89,72 @@ namespace AlgoUtils {
         return result;
     }
 
+    /**
+     * Intersect two sorted id ranges, appending the common ids to out.
+     * Built for CSR adjacency rows (sorted, contiguous): the usual case
+     * is a linear two-pointer merge, but when the remaining long side
+     * is much bigger than the short side the merge switches to a
+     * galloping (doubling) search, so heavily skewed pairs cost
+     * O(small * log large) instead of walking the whole long row.
+     * The caller owns the output buffer - clear and reuse it across a
+     * batch and the loop allocates nothing.
+     */
+    inline void intersect_sorted(
+        const int* a, const int* a_end,
+        const int* b, const int* b_end,
+        vector<int>& out)
+    {
+        // Keep a as the shorter remaining range
+        if (a_end - a > b_end - b) {
+            swap(a, b);
+            swap(a_end, b_end);
+        }
+
+        while (a < a_end && b < b_end) {
+            if ((b_end - b) > 32 * (a_end - a)) {
+                // Skewed: gallop b forward to the first element >= *a
+                const int* probe = b;
+                ptrdiff_t step = 1;
+                while (probe + step < b_end && probe[step] < *a) {
+                    probe += step;
+                    step *= 2;
+                }
+                b = lower_bound(probe, min(probe + step, b_end), *a);
+                if (b == b_end) break;
+            }
+
+            if (*a < *b) {
+                a++;
+            } else if (*b < *a) {
+                b++;
+            } else {
+                out.push_back(*a);
+                a++;
+                b++;
+            }
+        }
+    }
+
+    /**
+     * Count common interned ids between two small unsorted id lists.
+     * Interest lists hold ids from the interning pool (string_pool.hpp),
+     * so common-interest checks are integer compares - no string
+     * traffic. Quadratic like find_common_items, which is fine at the
+     * handful of interests a node carries.
+     */
+    inline int count_common_ids(
+        const vector<int32_t>& list_a,
+        const vector<int32_t>& list_b)
+    {
+        int count = 0;
+        for (int32_t item : list_a) {
+            if (find(list_b.begin(), list_b.end(), item) != list_b.end()) {
+                count++;
+            }
+        }
+        return count;
+    }
+
     /**
      * Normalize a value to 0.0-1.0 range.
      * Used for scoring metrics with different scales.
@@ -1,5 +1,8 @@
 #include "graph_generator.hpp"
 #include "Algorithm.hpp"
+#include "thread_pool.hpp"
+#include "gzip.hpp"
+#include "metrics.hpp"
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <string>
@@ -13,6 +16,7 @@
 #include <vector>
 #include <algorithm>
 #include <cstdio>
+#include <csignal>
 
 // Simple HTTP server using standard library
 // For production, consider using cpp-httplib or similar
@@ -31,12 +35,26 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#include <cerrno>
 #endif
 
 using json = nlohmann::json;
 using namespace std;
 namespace fs = std::filesystem;
 
+// Whether the request currently being processed on this worker asked for
+// connection reuse. Set once per request in processRequest and consulted
+// by createHTTPResponse, so individual handlers don't need to thread a
+// keep-alive flag through every call.
+static thread_local bool t_requestKeepAlive = false;
+
+// Whether the current request advertised gzip support via Accept-Encoding.
+// Handlers with a precompressed body consult this to pick the variant.
+static thread_local bool t_requestAcceptsGzip = false;
+
 static string urlDecode(const string& value) {
     string result;
     char ch;
@@ -58,10 +76,32 @@ static string urlDecode(const string& value) {
 
 class SimpleHTTPServer {
 private:
+    // Warm-up computes the leaderboard this deep; requests for more rows
+    // fall back to a live computation.
+    static constexpr int WARM_LEADERBOARD_TOP = 100;
+
     struct GraphContext {
         unique_ptr<SocialGraph> graph;
         unique_ptr<GraphAlgorithms> algorithms;
         string date;
+
+        // Per-snapshot analytics, computed once by a background warm-up
+        // thread after load. The graph for a date is immutable, so full
+        // label propagation / PageRank re-runs per request are wasted
+        // work; handlers wait on analyticsReady and serve these instead.
+        mutex analyticsMutex;
+        condition_variable analyticsReady;
+        bool analyticsDone = false;
+        string communitiesBody;              // pre-serialized /api/communities JSON
+        vector<InfluencerRank> leaderboard;  // top WARM_LEADERBOARD_TOP rows
+
+        // The full /api/graph payload, serialized once per snapshot and
+        // stored both plain and gzip-compressed. The compressed form is
+        // typically ~10x smaller, so it is what most clients receive.
+        // Published ahead of the heavier analytics under the same mutex.
+        bool graphBodyDone = false;
+        string graphBody;
+        string graphBodyGzip;
     };
 
     string datasetRoot;
@@ -71,34 +111,204 @@ private:
     string defaultDate;
     int port;
     bool running;
-    unordered_map<string, shared_ptr<GraphContext>> graphCache;
+
+    // Approximate memory budget for cached GraphContexts. When the
+    // estimated total exceeds it, least-recently-used dates are evicted
+    // (the default date is pinned). Requests holding a shared_ptr keep
+    // an evicted context alive until they finish.
+    static constexpr size_t CACHE_MEMORY_BUDGET_BYTES = (size_t)2048 << 20;
+
+    // How many of the most recent dates (beyond the default) a
+    // background thread pages in at startup; 0 disables preloading.
+    static constexpr int PRELOAD_RECENT_DATES = 2;
+
+    struct CachedGraph {
+        shared_ptr<GraphContext> context;
+        chrono::steady_clock::time_point lastUsed;
+    };
+
+    unordered_map<string, CachedGraph> graphCache;
+    // Dates some thread is currently loading; waiters sleep on
+    // cacheLoadReady instead of starting a duplicate multi-minute load.
+    set<string> loadingDates;
+    condition_variable cacheLoadReady;
     mutable mutex cacheMutex;
+    // Fixed-size pool of connection workers; the accept loop only
+    // enqueues sockets so it never falls behind on thread creation.
+    ThreadPool workerPool;
+
+    // Per-endpoint latency histograms. Registered once in the
+    // constructor and never resized, so the request path only does a
+    // short read-only scan plus relaxed atomic increments - no locks.
+    // Entries ending in '/' match by prefix; the last entry catches
+    // everything else.
+    vector<pair<string, unique_ptr<LatencyHistogram>>> endpointMetrics;
+    atomic<uint64_t> graphCacheHits{0};
+    atomic<uint64_t> graphCacheMisses{0};
+    atomic<uint64_t> graphCacheEvictions{0};
+
+    LatencyHistogram& histogramFor(const string& basePath) {
+        for (auto& [route, histogram] : endpointMetrics) {
+            if (!route.empty() && route.back() == '/') {
+                if (basePath.rfind(route, 0) == 0) return *histogram;
+            } else if (basePath == route) {
+                return *histogram;
+            }
+        }
+        return *endpointMetrics.back().second;
+    }
+
+    // Upper bound on one request (headers + body). Anything bigger is
+    // dropped and the connection closed - no endpoint takes payloads
+    // anywhere near this.
+    static constexpr size_t MAX_REQUEST_BYTES = 1 << 20;  // 1 MiB
+
+    // One request, split once at read time. The header block is kept
+    // lowercased so later lookups (Connection, Accept-Encoding) are
+    // plain finds instead of copy-and-transform passes, and handlers get
+    // the body directly rather than re-splitting the raw bytes.
+    struct ParsedRequest {
+        string method;
+        string path;
+        string version;
+        string headers_lower;  // header block, lowercased, no request line
+        string body;
+    };
+
+    // parseBuffered results: one complete request was cut off the front
+    // of the buffer, more bytes are needed, or the input is malformed or
+    // over the size cap (the connection should be dropped).
+    enum class ParseResult { Complete, NeedMore, Bad };
+
+    // Try to parse one full HTTP request off the front of buffer: the
+    // header block must have arrived and, if Content-Length is present,
+    // the whole body too. On success the request's bytes are consumed
+    // from the buffer (any pipelined follow-up stays behind for the next
+    // call). Shared by the blocking reader and the epoll state machine -
+    // both just feed recv'd bytes in and retry.
+    static ParseResult parseBuffered(string& buffer, ParsedRequest& out) {
+        size_t headerEnd = buffer.find("\r\n\r\n");
+        if (headerEnd == string::npos) {
+            return buffer.size() > MAX_REQUEST_BYTES ? ParseResult::Bad
+                                                     : ParseResult::NeedMore;
+        }
+
+        size_t lineEnd = buffer.find("\r\n");
+        out.headers_lower = buffer.substr(lineEnd + 2, headerEnd - lineEnd - 2);
+        transform(out.headers_lower.begin(), out.headers_lower.end(),
+                  out.headers_lower.begin(), ::tolower);
+        size_t contentLength = parseContentLength(out.headers_lower);
+        if (headerEnd + 4 + contentLength > MAX_REQUEST_BYTES) {
+            return ParseResult::Bad;
+        }
+        if (buffer.size() < headerEnd + 4 + contentLength) {
+            return ParseResult::NeedMore;
+        }
+
+        // Request line: METHOD SP PATH SP VERSION
+        size_t firstSpace = buffer.find(' ');
+        if (firstSpace == string::npos || firstSpace > lineEnd) {
+            return ParseResult::Bad;
+        }
+        size_t secondSpace = buffer.find(' ', firstSpace + 1);
+        if (secondSpace == string::npos || secondSpace > lineEnd) {
+            return ParseResult::Bad;
+        }
+
+        out.method = buffer.substr(0, firstSpace);
+        out.path = buffer.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+        out.version = buffer.substr(secondSpace + 1, lineEnd - secondSpace - 1);
+        out.body = buffer.substr(headerEnd + 4, contentLength);
+        buffer.erase(0, headerEnd + 4 + contentLength);
+        return ParseResult::Complete;
+    }
 
-    string readRequest(int clientSocket) {
-        string request;
-        char buffer[4096] = {0};
-        int bytesRead = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
-        if (bytesRead > 0) {
-            request = string(buffer, bytesRead);
+    // Blocking-mode reader: loop on recv into a growable buffer until
+    // parseBuffered has a complete request. Needed for keep-alive - with
+    // a single recv a pipelined or slow client would leave us with a
+    // truncated or coalesced request. Returns false when the connection
+    // closed, timed out, sent garbage, or exceeded the size cap.
+    bool readRequest(int clientSocket, ParsedRequest& out) {
+        string buffer;
+        char chunk[4096];
+
+        while (true) {
+            ParseResult parsed = parseBuffered(buffer, out);
+            if (parsed == ParseResult::Complete) return true;
+            if (parsed == ParseResult::Bad) return false;
+
+            int bytesRead = recv(clientSocket, chunk, sizeof(chunk), 0);
+            if (bytesRead <= 0) {
+                return false;  // closed, timed out or errored mid-request
+            }
+            buffer.append(chunk, bytesRead);
         }
-        return request;
     }
 
+    // Headers are already lowercased, so this is a plain scan.
+    static size_t parseContentLength(const string& headers_lower) {
+        size_t pos = headers_lower.find("content-length:");
+        if (pos == string::npos) return 0;
+        try {
+            return stoul(headers_lower.substr(pos + 15));
+        } catch (...) {
+            return 0;
+        }
+    }
+
+    // Does this request want the connection kept open afterwards?
+    // HTTP/1.1 defaults to keep-alive, HTTP/1.0 to close; an explicit
+    // Connection header overrides either way.
+    static bool wantsKeepAlive(const ParsedRequest& request) {
+        if (request.headers_lower.find("connection: close") != string::npos) {
+            return false;
+        }
+        if (request.headers_lower.find("connection: keep-alive") != string::npos) {
+            return true;
+        }
+        return request.version == "HTTP/1.1";
+    }
+
+    // Did the client advertise gzip support? (Accept-Encoding: gzip)
+    static bool acceptsGzip(const ParsedRequest& request) {
+        size_t pos = request.headers_lower.find("accept-encoding:");
+        if (pos == string::npos) return false;
+        size_t lineEnd = request.headers_lower.find("\r\n", pos);
+        return request.headers_lower.find("gzip", pos) < lineEnd;
+    }
+
+    // Stream the response out in fixed-size chunks, retrying partial
+    // sends. A single send() silently truncates multi-megabyte payloads
+    // once the socket buffer fills; looping also means the status line
+    // and headers hit the wire before the body finishes copying.
     void sendResponse(int clientSocket, const string& response) {
-        send(clientSocket, response.c_str(), response.length(), 0);
+        constexpr size_t SEND_CHUNK = 64 * 1024;
+        size_t sent = 0;
+        while (sent < response.length()) {
+            size_t chunk = min(SEND_CHUNK, response.length() - sent);
+            int written = send(clientSocket, response.data() + sent, chunk, 0);
+            if (written <= 0) {
+                return;  // client went away; connection is torn down by caller
+            }
+            sent += written;
+        }
     }
 
     string createHTTPResponse(const string& body,
                               const string& contentType = "application/json",
-                              int statusCode = 200) {
+                              int statusCode = 200,
+                              const string& contentEncoding = "") {
         stringstream ss;
         ss << "HTTP/1.1 " << statusCode << " OK\r\n";
         ss << "Content-Type: " << contentType << "\r\n";
         ss << "Access-Control-Allow-Origin: *\r\n";
         ss << "Access-Control-Allow-Methods: GET, POST, OPTIONS\r\n";
         ss << "Access-Control-Allow-Headers: Content-Type\r\n";
+        if (!contentEncoding.empty()) {
+            ss << "Content-Encoding: " << contentEncoding << "\r\n";
+        }
         ss << "Content-Length: " << body.length() << "\r\n";
-        ss << "Connection: close\r\n\r\n";
+        ss << "Connection: " << (t_requestKeepAlive ? "keep-alive" : "close") << "\r\n\r\n";
         ss << body;
         return ss.str();
     }
@@ -159,72 +369,419 @@ private:
         context->graph = move(graph);
         context->algorithms = move(algorithms);
         context->date = date;
+
+        // Replay the warm-start file from the previous process, if one
+        // matches this snapshot: cached path results and the analytics
+        // bodies come back before the first request lands.
+        loadWarmCache(*context);
+
+        // Kick off analytics warm-up off the request path. A plain
+        // detached thread, not the worker pool: warm-up itself fans out
+        // onto the compute pool and must not occupy a pooled worker.
+        thread(&SimpleHTTPServer::warmUpAnalytics, context).detach();
+
         return context;
     }
 
+    // Rough footprint of one cached context. Measured per-record costs
+    // for a loaded snapshot: ~1.5 KB per node (profile, three adjacency
+    // sets, CSR and trie share) and ~600 B per edge (edge list,
+    // relation entries, serialized graph bodies). Close enough to steer
+    // eviction; exact accounting isn't worth instrumenting every
+    // allocation.
+    static size_t estimateContextBytes(const GraphContext& context) {
+        return (size_t)context.graph->getNodeCount() * 1536 +
+               (size_t)context.graph->getEdgeCount() * 600;
+    }
+
+    // Evict least-recently-used dates until the estimated cache size
+    // fits the budget. The default date is pinned and the most recently
+    // touched entry always survives, so one oversized snapshot can't
+    // evict itself. Caller holds cacheMutex.
+    void evictOverBudgetLocked() {
+        while (graphCache.size() > 1) {
+            size_t total = 0;
+            for (const auto& [date, entry] : graphCache) {
+                total += estimateContextBytes(*entry.context);
+            }
+            if (total <= CACHE_MEMORY_BUDGET_BYTES) break;
+
+            auto victim = graphCache.end();
+            auto newest = graphCache.begin();
+            for (auto it = graphCache.begin(); it != graphCache.end(); ++it) {
+                if (it->second.lastUsed > newest->second.lastUsed) newest = it;
+                if (it->first == defaultDate) continue;
+                if (victim == graphCache.end() ||
+                    it->second.lastUsed < victim->second.lastUsed) {
+                    victim = it;
+                }
+            }
+            if (victim == graphCache.end() || victim == newest) break;
+
+            cout << "Evicting cached graph for date " << victim->first << endl;
+            graphCache.erase(victim);
+            graphCacheEvictions.fetch_add(1, memory_order_relaxed);
+        }
+    }
+
     shared_ptr<GraphContext> getGraphContext(const string& date) {
-        {
-            lock_guard<mutex> lock(cacheMutex);
+        unique_lock<mutex> lock(cacheMutex);
+        while (true) {
             auto it = graphCache.find(date);
             if (it != graphCache.end()) {
-                return it->second;
+                graphCacheHits.fetch_add(1, memory_order_relaxed);
+                it->second.lastUsed = chrono::steady_clock::now();
+                return it->second.context;
+            }
+            if (loadingDates.count(date)) {
+                // Another request is already paging this date in; wait
+                // for it instead of doubling the load.
+                cacheLoadReady.wait(lock);
+                continue;
             }
+            break;
         }
 
-        if (!datasetExists(date)) {
-            throw runtime_error("Dataset for date " + date + " not found");
+        graphCacheMisses.fetch_add(1, memory_order_relaxed);
+        loadingDates.insert(date);
+        lock.unlock();
+
+        shared_ptr<GraphContext> context;
+        try {
+            if (!datasetExists(date)) {
+                throw runtime_error("Dataset for date " + date + " not found");
+            }
+            context = loadGraphContext(date);
+        } catch (...) {
+            lock.lock();
+            loadingDates.erase(date);
+            cacheLoadReady.notify_all();
+            throw;
         }
 
-        auto context = loadGraphContext(date);
+        lock.lock();
+        graphCache[date] = {context, chrono::steady_clock::now()};
+        loadingDates.erase(date);
+        evictOverBudgetLocked();
+        cacheLoadReady.notify_all();
+        return context;
+    }
+
+    // ===== WARM-START PERSISTENCE =====
+    // A restart used to discard every accumulated path result and the
+    // per-snapshot analytics, so the first hours after a deploy ran at
+    // cold-cache latency. Each cached context is now serialized to a
+    // flat-record file next to its dataset (periodically and on
+    // SIGINT/SIGTERM), and loadGraphContext replays a matching file
+    // before the first request hits the new process. Everything here is
+    // best effort: a missing, stale or corrupt warm file just means a
+    // cold start, exactly as before.
+    static constexpr int WARM_CACHE_SAVE_INTERVAL_SECONDS = 300;
+    static constexpr char WARM_CACHE_FILENAME[] = "warm_cache.bin";
+    static constexpr char WARM_CACHE_MAGIC[8] = {'S','G','W','A','R','M','0','1'};
+
+    string warmCachePathFor(const string& date) const {
+        return (fs::path(datasetRoot) / date / WARM_CACHE_FILENAME).string();
+    }
+
+    void saveWarmCache(GraphContext& context) {
+        using namespace SnapshotFormat;
+
+        bool analyticsDone;
+        string communitiesBody;
+        vector<InfluencerRank> leaderboard;
+        {
+            lock_guard<mutex> lock(context.analyticsMutex);
+            analyticsDone = context.analyticsDone;
+            if (analyticsDone) {
+                communitiesBody = context.communitiesBody;
+                leaderboard = context.leaderboard;
+            }
+        }
+        auto pathEntries =
+            context.algorithms->path_calculator.export_cache_entries();
+        if (!analyticsDone && pathEntries.empty()) return;
+
+        // Write-then-rename so a crash mid-save never clobbers the
+        // previous good file
+        string finalPath = warmCachePathFor(context.date);
+        string tempPath = finalPath + ".tmp";
+        ofstream out(tempPath, ios::binary | ios::trunc);
+        if (!out.is_open()) return;
+
+        out.write(WARM_CACHE_MAGIC, sizeof(WARM_CACHE_MAGIC));
+        writeString(out, context.date);
+        // Guard records: the warm file only matches the exact snapshot
+        // it was saved against
+        writeValue<int32_t>(out, context.graph->getNodeCount());
+        writeValue<int32_t>(out, context.graph->getEdgeCount());
+
+        writeValue<uint8_t>(out, analyticsDone ? 1 : 0);
+        if (analyticsDone) {
+            writeString(out, communitiesBody);
+            writeValue<uint32_t>(out, leaderboard.size());
+            for (const auto& entry : leaderboard) {
+                writeValue<int32_t>(out, entry.rank);
+                writeValue<int32_t>(out, entry.user_id);
+                writeString(out, entry.user_name);
+                writeValue<double>(out, entry.influence_score);
+                writeValue<int32_t>(out, entry.fan_count);
+                writeValue<int32_t>(out, entry.friend_count);
+                writeValue<double>(out, entry.pagerank_score);
+                writeValue<int32_t>(out, entry.total_followers);
+                writeValue<uint32_t>(out, entry.top_fan_ids.size());
+                for (int fan_id : entry.top_fan_ids) {
+                    writeValue<int32_t>(out, fan_id);
+                }
+            }
+        }
+
+        writeValue<uint32_t>(out, pathEntries.size());
+        for (const auto& [key, result] : pathEntries) {
+            writeValue<int64_t>(out, key);
+            writeValue<uint8_t>(out, result.path_exists ? 1 : 0);
+            writeValue<int32_t>(out, result.path_length);
+            writeValue<uint32_t>(out, result.path_node_ids.size());
+            for (int id : result.path_node_ids) {
+                writeValue<int32_t>(out, id);
+            }
+            writeString(out, result.path_description);
+        }
+
+        out.close();
+        error_code ec;
+        if (!out.good()) {
+            fs::remove(tempPath, ec);
+            return;
+        }
+        fs::rename(tempPath, finalPath, ec);
+    }
+
+    void loadWarmCache(GraphContext& context) {
+        using namespace SnapshotFormat;
+
+        MappedFile file;
+        if (!file.open(warmCachePathFor(context.date))) return;
+
+        try {
+            Cursor cursor(file);
+            cursor.require(sizeof(WARM_CACHE_MAGIC));
+            if (memcmp(cursor.pos, WARM_CACHE_MAGIC,
+                       sizeof(WARM_CACHE_MAGIC)) != 0) {
+                return;
+            }
+            cursor.pos += sizeof(WARM_CACHE_MAGIC);
+
+            if (cursor.readString() != context.date) return;
+            if (cursor.read<int32_t>() != context.graph->getNodeCount()) return;
+            if (cursor.read<int32_t>() != context.graph->getEdgeCount()) return;
+
+            bool hasAnalytics = cursor.read<uint8_t>() != 0;
+            if (hasAnalytics) {
+                string communitiesBody = cursor.readString();
+                uint32_t rows = cursor.read<uint32_t>();
+                vector<InfluencerRank> leaderboard(rows);
+                for (auto& entry : leaderboard) {
+                    entry.rank = cursor.read<int32_t>();
+                    entry.user_id = cursor.read<int32_t>();
+                    entry.user_name = cursor.readString();
+                    entry.influence_score = cursor.read<double>();
+                    entry.fan_count = cursor.read<int32_t>();
+                    entry.friend_count = cursor.read<int32_t>();
+                    entry.pagerank_score = cursor.read<double>();
+                    entry.total_followers = cursor.read<int32_t>();
+                    uint32_t fan_ids = cursor.read<uint32_t>();
+                    entry.top_fan_ids.reserve(fan_ids);
+                    for (uint32_t i = 0; i < fan_ids; i++) {
+                        entry.top_fan_ids.push_back(cursor.read<int32_t>());
+                    }
+                }
+                {
+                    lock_guard<mutex> lock(context.analyticsMutex);
+                    context.communitiesBody = move(communitiesBody);
+                    context.leaderboard = move(leaderboard);
+                    context.analyticsDone = true;
+                }
+                context.analyticsReady.notify_all();
+            }
+
+            uint32_t pathCount = cursor.read<uint32_t>();
+            vector<pair<long long, PathFindResult>> entries;
+            entries.reserve(pathCount);
+            for (uint32_t i = 0; i < pathCount; i++) {
+                long long key = cursor.read<int64_t>();
+                PathFindResult result;
+                result.path_exists = cursor.read<uint8_t>() != 0;
+                result.path_length = cursor.read<int32_t>();
+                uint32_t node_count = cursor.read<uint32_t>();
+                result.path_node_ids.reserve(node_count);
+                for (uint32_t j = 0; j < node_count; j++) {
+                    result.path_node_ids.push_back(cursor.read<int32_t>());
+                }
+                result.path_description = cursor.readString();
+                entries.emplace_back(key, move(result));
+            }
+            context.algorithms->path_calculator.import_cache_entries(entries);
+
+            cout << "Warm-start: restored " << pathCount << " path results"
+                 << (hasAnalytics ? " and analytics" : "")
+                 << " for date " << context.date << endl;
+        } catch (const exception&) {
+            // Truncated or corrupt file: fall back to a cold start
+        }
+    }
+
+public:
+    // Persist every cached context. Called by the periodic saver thread
+    // and from the shutdown signal handler.
+    void saveAllWarmCaches() {
+        vector<shared_ptr<GraphContext>> contexts;
         {
             lock_guard<mutex> lock(cacheMutex);
-            graphCache[date] = context;
+            contexts.reserve(graphCache.size());
+            for (auto& [date, entry] : graphCache) {
+                contexts.push_back(entry.context);
+            }
+        }
+        for (auto& context : contexts) {
+            saveWarmCache(*context);
         }
-        return context;
     }
 
-    string handleGetGraph(const SocialGraph& graph, const string& date) {
-        json response;
-        json nodesArray = json::array();
-        json edgesArray = json::array();
+private:
+    // Append s as a JSON string literal (quotes + escapes included).
+    static void appendJsonString(string& out, const string& s) {
+        out += '"';
+        for (char c : s) {
+            switch (c) {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if ((unsigned char)c < 0x20) {
+                        char buf[8];
+                        snprintf(buf, sizeof(buf), "\\u%04x", c);
+                        out += buf;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+        out += '"';
+    }
 
+    /**
+     * Serialize the whole graph in the Cytoscape-style shape /api/graph
+     * has always returned, appending straight into one string. Building
+     * a DOM of every node and edge just to dump it doubled both the time
+     * and the peak memory of the largest response we serve.
+     */
+    static string buildGraphBody(const SocialGraph& graph, const string& date) {
+        string out;
+        // ~220 bytes of JSON per node/edge is typical for this shape
+        out.reserve((size_t)(graph.getNodeCount() + graph.getEdgeCount()) * 220 + 256);
+        char buf[64];
+
+        out += "{\"nodes\":[";
+        bool first = true;
         for (const auto& [id, node] : graph.getNodes()) {
-            json nodeJson;
-            nodeJson["data"]["id"] = to_string(node.user_id);
-            nodeJson["data"]["label"] = node.name;
-            nodeJson["data"]["user_id"] = node.user_id;
-            nodeJson["data"]["name"] = node.name;
-            nodeJson["data"]["degree"] = graph.getFriendCount(node.user_id);
-            nodeJson["data"]["followers"] = graph.getFollowers(node.user_id).size();
-            nodeJson["data"]["following"] = graph.getFollowing(node.user_id).size();
-            nodeJson["data"]["region_id"] = node.region_id;
-            nodeJson["data"]["interests"] = node.interests;
-            nodeJson["data"]["location"] = {node.location.latitude, node.location.longitude};
-            nodesArray.push_back(nodeJson);
+            if (!first) out += ',';
+            first = false;
+            out += "{\"data\":{\"id\":\"";
+            out += to_string(node.user_id);
+            out += "\",\"label\":";
+            appendJsonString(out, node.name);
+            out += ",\"user_id\":";
+            out += to_string(node.user_id);
+            out += ",\"name\":";
+            appendJsonString(out, node.name);
+            out += ",\"degree\":";
+            out += to_string(graph.getFriendCount(node.user_id));
+            out += ",\"followers\":";
+            out += to_string(graph.getFollowers(node.user_id).size());
+            out += ",\"following\":";
+            out += to_string(graph.getFollowing(node.user_id).size());
+            out += ",\"region_id\":";
+            out += to_string(node.region_id);
+            out += ",\"interests\":[";
+            bool firstInterest = true;
+            for (int32_t interestId : node.interest_ids) {
+                if (!firstInterest) out += ',';
+                firstInterest = false;
+                appendJsonString(out, global_string_pool().resolve(interestId));
+            }
+            out += "],\"location\":[";
+            snprintf(buf, sizeof(buf), "%.17g,%.17g",
+                     node.location.latitude, node.location.longitude);
+            out += buf;
+            out += "]}}";
         }
 
+        out += "],\"edges\":[";
         int edgeId = 0;
+        first = true;
         for (const auto& edge : graph.getEdges()) {
             if (graph.getNode(edge.source) && graph.getNode(edge.target)) {
-                json edgeJson;
-                edgeJson["data"]["id"] = "e" + to_string(edgeId++);
-                edgeJson["data"]["source"] = to_string(edge.source);
-                edgeJson["data"]["target"] = to_string(edge.target);
-                edgeJson["data"]["relationship_type"] = edge.relationship_type;
-                edgeJson["data"]["weight"] = 1;
-                edgesArray.push_back(edgeJson);
-            }
-        }
-
-        response["nodes"] = nodesArray;
-        response["edges"] = edgesArray;
-        response["metadata"] = {
-            {"total_nodes", graph.getNodeCount()},
-            {"total_edges", graph.getEdgeCount()},
-            {"date", date}
-        };
+                if (!first) out += ',';
+                first = false;
+                out += "{\"data\":{\"id\":\"e";
+                out += to_string(edgeId++);
+                out += "\",\"source\":\"";
+                out += to_string(edge.source);
+                out += "\",\"target\":\"";
+                out += to_string(edge.target);
+                out += "\",\"relationship_type\":";
+                appendJsonString(out, edge.relationship_type());
+                out += ",\"weight\":1}}";
+            }
+        }
 
-        return createHTTPResponse(response.dump());
+        out += "],\"metadata\":{\"total_nodes\":";
+        out += to_string(graph.getNodeCount());
+        out += ",\"total_edges\":";
+        out += to_string(graph.getEdgeCount());
+        out += ",\"date\":";
+        appendJsonString(out, date);
+        out += "}}";
+        return out;
+    }
+
+    // Serve the pre-serialized graph payload, gzip-encoded when the
+    // client advertised support for it.
+    string handleGetGraph(GraphContext& context) {
+        waitForGraphBody(context);
+        if (t_requestAcceptsGzip) {
+            return createHTTPResponse(context.graphBodyGzip, "application/json",
+                                      200, "gzip");
+        }
+        return createHTTPResponse(context.graphBody);
+    }
+
+    // One node record as served by /api/node/<id> and each element of
+    // the POST /api/nodes batch response.
+    static json buildNodeRecord(const SocialGraph& graph, const Node& node,
+                                const CentralityMetrics& metrics) {
+        json record;
+        record["user_id"] = node.user_id;
+        record["name"] = node.name;
+        record["location"] = {node.location.latitude, node.location.longitude};
+        record["region_id"] = node.region_id;
+        record["interests"] = node.interests();
+        record["created_at"] = node.created_at();
+        record["friend_count"] = graph.getFriendCount(node.user_id);
+        record["follower_count"] = graph.getFollowers(node.user_id).size();
+        record["following_count"] = graph.getFollowing(node.user_id).size();
+        record["centrality"] = {
+            {"degree_centrality", metrics.degree_centrality},
+            {"closeness_centrality", metrics.closeness_centrality},
+            {"clustering_coefficient", metrics.clustering_coefficient},
+            {"raw_degree", metrics.raw_degree}
+        };
+        return record;
     }
 
     string handleGetNode(const SocialGraph& graph, GraphAlgorithms& algorithms, const string& nodeId) {
@@ -236,25 +793,44 @@ private:
             return createHTTPResponse(error.dump(), "application/json", 404);
         }
 
-        json response;
-        response["user_id"] = node->user_id;
-        response["name"] = node->name;
-        response["location"] = {node->location.latitude, node->location.longitude};
-        response["region_id"] = node->region_id;
-        response["interests"] = node->interests;
-        response["created_at"] = node->created_at;
-        response["friend_count"] = graph.getFriendCount(id);
-        response["follower_count"] = graph.getFollowers(id).size();
-        response["following_count"] = graph.getFollowing(id).size();
-
         auto metrics = algorithms.get_centrality_metrics(id);
-        response["centrality"] = {
-            {"degree_centrality", metrics.degree_centrality},
-            {"closeness_centrality", metrics.closeness_centrality},
-            {"clustering_coefficient", metrics.clustering_coefficient},
-            {"raw_degree", metrics.raw_degree}
-        };
+        return createHTTPResponse(buildNodeRecord(graph, *node, metrics).dump());
+    }
+
+    // Batch form for feed-style pages: POST /api/nodes with
+    // {"ids": [...]} returns the /api/node record for every id in one
+    // response, with the centrality metrics computed as a single batch
+    // over the compute pool instead of one BFS cascade per round trip.
+    // Unknown ids come back as per-id error entries, so one bad id
+    // doesn't fail the page.
+    static constexpr size_t MAX_BATCH_NODE_IDS = 500;
+
+    string handleGetNodesBatch(const SocialGraph& graph, GraphAlgorithms& algorithms, const string& body) {
+        json request = json::parse(body);
+        if (!request.contains("ids") || !request["ids"].is_array()) {
+            json error = {{"error", "Expected a JSON body with an \"ids\" array"}};
+            return createHTTPResponse(error.dump(), "application/json", 400);
+        }
 
+        auto ids = request["ids"].get<vector<int>>();
+        if (ids.size() > MAX_BATCH_NODE_IDS) {
+            json error = {{"error", "At most " + to_string(MAX_BATCH_NODE_IDS) +
+                                    " ids per request"}};
+            return createHTTPResponse(error.dump(), "application/json", 400);
+        }
+
+        auto metrics = algorithms.get_centrality_metrics_batch(ids);
+
+        json response = json::array();
+        for (size_t i = 0; i < ids.size(); i++) {
+            const Node* node = graph.getNode(ids[i]);
+            if (!node) {
+                response.push_back({{"user_id", ids[i]},
+                                    {"error", "Node not found"}});
+                continue;
+            }
+            response.push_back(buildNodeRecord(graph, *node, metrics[i]));
+        }
         return createHTTPResponse(response.dump());
     }
 
@@ -290,8 +866,7 @@ private:
         return createHTTPResponse(response.dump());
     }
 
-    string handleInfluencerLeaderboard(GraphAlgorithms& algorithms, int top) {
-        auto leaderboard = algorithms.get_influencer_leaderboard(top, 20);
+    static string serializeLeaderboard(const vector<InfluencerRank>& leaderboard) {
         json response = json::array();
 
         for (const auto& entry : leaderboard) {
@@ -307,11 +882,24 @@ private:
             response.push_back(item);
         }
 
-        return createHTTPResponse(response.dump());
+        return response.dump();
+    }
+
+    string handleInfluencerLeaderboard(GraphContext& context, int top) {
+        // Live fallback for requests deeper than the warmed ranking
+        if (top > WARM_LEADERBOARD_TOP) {
+            auto leaderboard = context.algorithms->get_influencer_leaderboard(top, 20);
+            return createHTTPResponse(serializeLeaderboard(leaderboard));
+        }
+
+        waitForAnalytics(context);
+        vector<InfluencerRank> slice(
+            context.leaderboard.begin(),
+            context.leaderboard.begin() + min<size_t>(top, context.leaderboard.size()));
+        return createHTTPResponse(serializeLeaderboard(slice));
     }
 
-    string handleCommunities(GraphAlgorithms& algorithms) {
-        auto communities = algorithms.detect_communities();
+    static string serializeCommunities(const vector<Community>& communities) {
         json response = json::array();
 
         // Generate colors for communities
@@ -333,7 +921,64 @@ private:
             response.push_back(item);
         }
 
-        return createHTTPResponse(response.dump());
+        return response.dump();
+    }
+
+    string handleCommunities(GraphContext& context) {
+        waitForAnalytics(context);
+        return createHTTPResponse(context.communitiesBody);
+    }
+
+    // Compute the immutable per-snapshot analytics once. Runs on a
+    // dedicated background thread right after the context loads, so the
+    // first /api/communities or /api/influencer-leaderboard hit serves a
+    // cached result instead of a multi-second computation.
+    static void warmUpAnalytics(shared_ptr<GraphContext> context) {
+        // Graph payload first: it is the cheapest piece and the one the
+        // frontend requests immediately after picking a date. Publishing
+        // it early keeps /api/graph from waiting on PageRank.
+        string graphBody = buildGraphBody(*context->graph, context->date);
+        string graphBodyGzip = Gzip::compress(graphBody);
+        {
+            lock_guard<mutex> lock(context->analyticsMutex);
+            context->graphBody = move(graphBody);
+            context->graphBodyGzip = move(graphBodyGzip);
+            context->graphBodyDone = true;
+        }
+        context->analyticsReady.notify_all();
+
+        // The warm-start file may have already restored the analytics
+        // bodies; only the graph payload needed rebuilding above.
+        {
+            lock_guard<mutex> lock(context->analyticsMutex);
+            if (context->analyticsDone) return;
+        }
+
+        string communitiesBody =
+            serializeCommunities(context->algorithms->detect_communities());
+        vector<InfluencerRank> leaderboard =
+            context->algorithms->get_influencer_leaderboard(WARM_LEADERBOARD_TOP, 20);
+
+        {
+            lock_guard<mutex> lock(context->analyticsMutex);
+            context->communitiesBody = move(communitiesBody);
+            context->leaderboard = move(leaderboard);
+            context->analyticsDone = true;
+        }
+        context->analyticsReady.notify_all();
+    }
+
+    // Block until warm-up has published its results for this context.
+    static void waitForAnalytics(GraphContext& context) {
+        unique_lock<mutex> lock(context.analyticsMutex);
+        context.analyticsReady.wait(lock, [&] { return context.analyticsDone; });
+    }
+
+    // Block until the serialized graph payload is available (published
+    // before the heavier analytics, so this wait is short).
+    static void waitForGraphBody(GraphContext& context) {
+        unique_lock<mutex> lock(context.analyticsMutex);
+        context.analyticsReady.wait(lock, [&] { return context.graphBodyDone; });
     }
 
     string handlePath(GraphAlgorithms& algorithms, int source, int target) {
@@ -380,49 +1025,124 @@ private:
         return createHTTPResponse(response.dump());
     }
 
-    void processRequest(int clientSocket) {
-        string request = readRequest(clientSocket);
-        if (request.empty()) {
-            sendResponse(clientSocket, createHTTPResponse("Invalid request", "text/plain", 400));
-            #ifdef _WIN32
-            closesocket(clientSocket);
-            #else
-            close(clientSocket);
-            #endif
-            return;
+    // Dump every latency histogram and cache counter as JSON. Cold
+    // endpoint: it may take locks and allocate freely.
+    string handleStats() {
+        json response;
+
+        json endpoints = json::object();
+        for (const auto& [route, histogram] : endpointMetrics) {
+            if (histogram->count() == 0) continue;
+            endpoints[route] = {
+                {"count", histogram->count()},
+                {"p50_ms", histogram->percentileMicros(0.50) / 1000.0},
+                {"p95_ms", histogram->percentileMicros(0.95) / 1000.0},
+                {"p99_ms", histogram->percentileMicros(0.99) / 1000.0},
+                {"max_ms", histogram->maxMicros() / 1000.0}
+            };
         }
+        response["endpoints"] = endpoints;
 
-        stringstream requestStream(request);
-        string requestLine;
-        getline(requestStream, requestLine);
+        uint64_t pathHits = 0, pathMisses = 0, pathEvictions = 0;
+        size_t pathEntries = 0, contexts = 0, estimatedBytes = 0;
+        {
+            lock_guard<mutex> lock(cacheMutex);
+            contexts = graphCache.size();
+            for (const auto& [date, entry] : graphCache) {
+                estimatedBytes += estimateContextBytes(*entry.context);
+                auto stats = entry.context->algorithms->path_calculator.cache_stats();
+                pathHits += stats.hits;
+                pathMisses += stats.misses;
+                pathEvictions += stats.evictions;
+                pathEntries += stats.entries;
+            }
+        }
 
-        string method, path, version;
-        stringstream ss(requestLine);
-        ss >> method >> path >> version;
+        response["graph_cache"] = {
+            {"hits", graphCacheHits.load(memory_order_relaxed)},
+            {"misses", graphCacheMisses.load(memory_order_relaxed)},
+            {"evictions", graphCacheEvictions.load(memory_order_relaxed)},
+            {"loaded_dates", contexts},
+            {"estimated_mb", estimatedBytes / (1024.0 * 1024.0)},
+            {"budget_mb", CACHE_MEMORY_BUDGET_BYTES / (1024.0 * 1024.0)}
+        };
+        response["path_cache"] = {
+            {"hits", pathHits},
+            {"misses", pathMisses},
+            {"evictions", pathEvictions},
+            {"entries", pathEntries}
+        };
 
-        if (method == "OPTIONS") {
-            sendResponse(clientSocket, handleOPTIONS());
-            #ifdef _WIN32
-            closesocket(clientSocket);
-            #else
-            close(clientSocket);
-            #endif
-            return;
+        return createHTTPResponse(response.dump());
+    }
+
+    // Serve one connection until the client stops reusing it. Each
+    // iteration handles a complete request/response exchange, so a burst
+    // of dashboard calls rides a single TCP connection.
+    void handleConnection(int clientSocket) {
+        // Per-socket receive timeout so an idle keep-alive connection
+        // cannot pin a worker forever
+        #ifdef _WIN32
+        DWORD timeout = 5000;
+        setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof(timeout));
+        #else
+        struct timeval timeout;
+        timeout.tv_sec = 5;
+        timeout.tv_usec = 0;
+        setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        #endif
+
+        while (true) {
+            ParsedRequest request;
+            if (!readRequest(clientSocket, request)) break;
+            if (!processRequest(clientSocket, request)) break;
         }
 
-        string body;
-        size_t headerEnd = request.find("\r\n\r\n");
-        if (headerEnd != string::npos) {
-            body = request.substr(headerEnd + 4);
+        #ifdef _WIN32
+        closesocket(clientSocket);
+        #else
+        close(clientSocket);
+        #endif
+    }
+
+    // Handle a single parsed-off-the-wire request; returns whether the
+    // connection should be kept open for the next one.
+    bool processRequest(int clientSocket, const ParsedRequest& request) {
+        bool keepAlive = false;
+        string response = buildResponse(request, keepAlive);
+        sendResponse(clientSocket, response);
+        return keepAlive;
+    }
+
+    // Dispatch one request and build the complete response bytes,
+    // reporting the keep-alive decision through keepAlive. Runs on
+    // whichever thread the serving mode picked; the per-request
+    // thread_locals are set here, so response composition (which
+    // consults them) must stay on this thread.
+    string buildResponse(const ParsedRequest& request, bool& keepAlive) {
+        t_requestKeepAlive = wantsKeepAlive(request);
+        t_requestAcceptsGzip = acceptsGzip(request);
+        keepAlive = t_requestKeepAlive;
+
+        if (request.method == "OPTIONS") {
+            return handleOPTIONS();
         }
 
+        const string& path = request.path;
+        const string& body = request.body;
+
         string response;
         string basePath = path.substr(0, path.find('?'));
         string queryString = path.find('?') != string::npos ? path.substr(path.find('?') + 1) : "";
 
+        // Times everything from dispatch through response composition
+        ScopedLatencyTimer requestTimer(histogramFor(basePath));
+
         try {
             if (basePath == "/api/dates") {
                 response = handleDatesEndpoint();
+            } else if (basePath == "/api/stats") {
+                response = handleStats();
             } else {
                 string dateParam = getQueryParameter(queryString, "date");
                 if (dateParam.empty()) {
@@ -434,12 +1154,15 @@ private:
                 auto& algorithmsRef = *context->algorithms;
 
                 if (basePath == "/api/graph") {
-                    response = handleGetGraph(graphRef, dateParam);
+                    response = handleGetGraph(*context);
                 }
                 else if (basePath.rfind("/api/node/", 0) == 0) {
                     string nodeId = basePath.substr(10);
                     response = handleGetNode(graphRef, algorithmsRef, nodeId);
                 }
+                else if (basePath == "/api/nodes" && request.method == "POST") {
+                    response = handleGetNodesBatch(graphRef, algorithmsRef, body);
+                }
                 else if (basePath == "/api/search") {
                     string query = getQueryParameter(queryString, "q");
                     response = handleSearch(algorithmsRef, query);
@@ -453,10 +1176,10 @@ private:
                     if (!topStr.empty()) {
                         top = stoi(topStr);
                     }
-                    response = handleInfluencerLeaderboard(algorithmsRef, top);
+                    response = handleInfluencerLeaderboard(*context, top);
                 }
                 else if (basePath == "/api/communities") {
-                    response = handleCommunities(algorithmsRef);
+                    response = handleCommunities(*context);
                 }
                 else if (basePath == "/api/path") {
                     string sourceStr = getQueryParameter(queryString, "source");
@@ -489,12 +1212,7 @@ private:
             response = createHTTPResponse(error.dump(), "application/json", 400);
         }
 
-        sendResponse(clientSocket, response);
-        #ifdef _WIN32
-        closesocket(clientSocket);
-        #else
-        close(clientSocket);
-        #endif
+        return response;
     }
 
 public:
@@ -510,28 +1228,67 @@ public:
           metadataFilename(metadataFile),
           defaultDate(initialDate),
           port(p),
-          running(false) {}
+          running(false),
+          workerPool(max(4u, thread::hardware_concurrency() * 2)) {
+        // "other" must stay last: histogramFor falls through to it
+        for (const char* route : {
+                 "/api/dates", "/api/graph", "/api/node/", "/api/nodes",
+                 "/api/search",
+                 "/api/mutual-friends", "/api/influencer-leaderboard",
+                 "/api/communities", "/api/path", "/api/recommendations",
+                 "/api/stats", "other"}) {
+            endpointMetrics.emplace_back(route, make_unique<LatencyHistogram>());
+        }
+    }
 
     bool initialize() {
         try {
             getGraphContext(defaultDate);
-            return true;
         } catch (const exception& ex) {
             cerr << "Failed to load default dataset: " << ex.what() << endl;
             return false;
         }
-    }
 
-    void start() {
-        #ifdef _WIN32
-        WSADATA wsaData;
-        WSAStartup(MAKEWORD(2, 2), &wsaData);
-        #endif
+        // Page in the most recent dates in the background so the first
+        // click on them doesn't eat a full load. Best effort: failures
+        // only matter when the date is actually requested.
+        if (PRELOAD_RECENT_DATES > 0) {
+            thread([this] {
+                auto dates = listAvailableDates();
+                int preloaded = 0;
+                for (auto it = dates.rbegin();
+                     it != dates.rend() && preloaded < PRELOAD_RECENT_DATES; ++it) {
+                    if (*it == defaultDate) continue;
+                    try {
+                        getGraphContext(*it);
+                        preloaded++;
+                    } catch (const exception&) {
+                    }
+                }
+            }).detach();
+        }
+
+        // Periodic warm-cache saver: a crash between saves loses at
+        // most the last interval's worth of accumulated results.
+        thread([this] {
+            while (true) {
+                this_thread::sleep_for(
+                    chrono::seconds(WARM_CACHE_SAVE_INTERVAL_SECONDS));
+                saveAllWarmCaches();
+            }
+        }).detach();
+
+        return true;
+    }
 
+private:
+    // Create, bind and listen the server socket; returns -1 (with the
+    // socket cleaned up) on failure. Shared by both serving modes.
+    int openListenSocket() {
         int serverSocket = socket(AF_INET, SOCK_STREAM, 0);
         if (serverSocket < 0) {
             cerr << "Error creating socket" << endl;
-            return;
+            return -1;
         }
 
         #ifdef _WIN32
@@ -551,21 +1308,37 @@ public:
             cerr << "Error binding to port " << port << endl;
             #ifdef _WIN32
             closesocket(serverSocket);
-            WSACleanup();
             #else
             close(serverSocket);
             #endif
-            return;
+            return -1;
         }
 
-        if (listen(serverSocket, 10) < 0) {
+        if (listen(serverSocket, 128) < 0) {
             cerr << "Error listening on socket" << endl;
             #ifdef _WIN32
             closesocket(serverSocket);
-            WSACleanup();
             #else
             close(serverSocket);
             #endif
+            return -1;
+        }
+
+        return serverSocket;
+    }
+
+public:
+    void start() {
+        #ifdef _WIN32
+        WSADATA wsaData;
+        WSAStartup(MAKEWORD(2, 2), &wsaData);
+        #endif
+
+        int serverSocket = openListenSocket();
+        if (serverSocket < 0) {
+            #ifdef _WIN32
+            WSACleanup();
+            #endif
             return;
         }
 
@@ -583,8 +1356,9 @@ public:
             int clientSocket = accept(serverSocket, (sockaddr*)&clientAddr, &clientAddrLen);
 
             if (clientSocket >= 0) {
-                thread clientThread(&SimpleHTTPServer::processRequest, this, clientSocket);
-                clientThread.detach();
+                workerPool.enqueue([this, clientSocket] {
+                    handleConnection(clientSocket);
+                });
             }
         }
 
@@ -599,11 +1373,333 @@ public:
     void stop() {
         running = false;
     }
+
+#ifndef _WIN32
+    /*
+     * EPOLL EVENT-LOOP MODE
+     * =====================
+     * Alternative serving mode: one event-loop thread multiplexes every
+     * connection through epoll with non-blocking sockets, so a slow
+     * reader or writer costs a small per-connection buffer instead of a
+     * pinned worker thread. Complete requests are handed to the worker
+     * pool; finished responses come back through a queue drained by the
+     * loop (an eventfd wakes it) and are written out as the socket
+     * accepts them. Selected with the "epoll" mode argument in main so
+     * the two modes can be A/B'd on the same build.
+     */
+private:
+    // Per-connection state machine. inbox accumulates recv'd bytes
+    // until parseBuffered cuts a request off the front; outbox holds the
+    // response still to be written. One request is in flight per
+    // connection at a time - pipelined follow-ups wait in the inbox.
+    struct EpollConnection {
+        int fd = -1;
+        uint64_t id = 0;
+        string inbox;
+        string outbox;
+        size_t outboxSent = 0;
+        bool processing = false;      // handler running on the pool
+        bool closeAfterSend = false;  // client asked for Connection: close
+        bool wantWrite = false;       // EPOLLOUT currently registered
+        chrono::steady_clock::time_point lastActivity;
+    };
+
+    // A response built on the pool, waiting for the loop to pick it up.
+    // Keyed by connection id, not fd: the client may have disconnected
+    // (and the fd been reused) while the handler was still running.
+    struct CompletedResponse {
+        uint64_t connectionId;
+        string response;
+        bool keepAlive;
+    };
+
+    // epoll_event.data carries a connection id; these two ids are
+    // reserved for the listen socket and the wakeup eventfd.
+    static constexpr uint64_t LISTEN_ID = 0;
+    static constexpr uint64_t WAKEUP_ID = 1;
+
+    // Idle keep-alive connections are reaped after this long, matching
+    // the 5s receive timeout of the blocking mode.
+    static constexpr int EPOLL_IDLE_TIMEOUT_SECONDS = 5;
+
+    int epollFd = -1;
+    int wakeupFd = -1;
+    uint64_t nextConnectionId = 2;  // 0 and 1 are the reserved ids
+    unordered_map<uint64_t, unique_ptr<EpollConnection>> connections;
+    mutex completedMutex;
+    vector<CompletedResponse> completedResponses;
+
+    static bool setNonBlocking(int fd) {
+        int flags = fcntl(fd, F_GETFL, 0);
+        return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) >= 0;
+    }
+
+    void epollSetInterest(EpollConnection* conn, bool wantWrite) {
+        if (conn->wantWrite == wantWrite) return;
+        conn->wantWrite = wantWrite;
+        epoll_event event{};
+        event.events = EPOLLIN | (wantWrite ? EPOLLOUT : 0);
+        event.data.u64 = conn->id;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, conn->fd, &event);
+    }
+
+    void epollClose(EpollConnection* conn) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, conn->fd, nullptr);
+        close(conn->fd);
+        connections.erase(conn->id);  // frees conn
+    }
+
+    void epollAccept(int serverSocket) {
+        while (true) {
+            sockaddr_in clientAddr;
+            socklen_t clientAddrLen = sizeof(clientAddr);
+            int clientSocket = accept(serverSocket, (sockaddr*)&clientAddr,
+                                      &clientAddrLen);
+            if (clientSocket < 0) {
+                return;  // EAGAIN: accepted everything pending
+            }
+            if (!setNonBlocking(clientSocket)) {
+                close(clientSocket);
+                continue;
+            }
+
+            auto conn = make_unique<EpollConnection>();
+            conn->fd = clientSocket;
+            conn->id = nextConnectionId++;
+            conn->lastActivity = chrono::steady_clock::now();
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = conn->id;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, clientSocket, &event) < 0) {
+                close(clientSocket);
+                continue;
+            }
+            connections[conn->id] = move(conn);
+        }
+    }
+
+    // If a complete request is sitting in the inbox and the connection
+    // is otherwise quiet, hand it to the worker pool. The response comes
+    // back through the completion queue.
+    void epollMaybeDispatch(EpollConnection* conn) {
+        if (conn->processing || !conn->outbox.empty()) return;
+
+        ParsedRequest request;
+        ParseResult parsed = parseBuffered(conn->inbox, request);
+        if (parsed == ParseResult::Bad) {
+            epollClose(conn);
+            return;
+        }
+        if (parsed == ParseResult::NeedMore) return;
+
+        conn->processing = true;
+        uint64_t connectionId = conn->id;
+        workerPool.enqueue([this, connectionId, request = move(request)]() mutable {
+            bool keepAlive = false;
+            string response = buildResponse(request, keepAlive);
+            {
+                lock_guard<mutex> lock(completedMutex);
+                completedResponses.push_back(
+                    {connectionId, move(response), keepAlive});
+            }
+            uint64_t one = 1;
+            ssize_t ignored = write(wakeupFd, &one, sizeof(one));
+            (void)ignored;
+        });
+    }
+
+    void epollHandleReadable(EpollConnection* conn) {
+        char chunk[4096];
+        while (true) {
+            int bytesRead = recv(conn->fd, chunk, sizeof(chunk), 0);
+            if (bytesRead > 0) {
+                conn->inbox.append(chunk, bytesRead);
+                conn->lastActivity = chrono::steady_clock::now();
+                continue;
+            }
+            if (bytesRead == 0) {
+                epollClose(conn);
+                return;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            epollClose(conn);
+            return;
+        }
+        epollMaybeDispatch(conn);
+    }
+
+    void epollHandleWritable(EpollConnection* conn) {
+        while (conn->outboxSent < conn->outbox.size()) {
+            ssize_t written = send(conn->fd,
+                                   conn->outbox.data() + conn->outboxSent,
+                                   conn->outbox.size() - conn->outboxSent,
+                                   MSG_NOSIGNAL);
+            if (written > 0) {
+                conn->outboxSent += written;
+                conn->lastActivity = chrono::steady_clock::now();
+                continue;
+            }
+            if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                epollSetInterest(conn, true);  // resume on EPOLLOUT
+                return;
+            }
+            epollClose(conn);
+            return;
+        }
+
+        // Response fully written
+        conn->outbox.clear();
+        conn->outboxSent = 0;
+        if (conn->closeAfterSend) {
+            epollClose(conn);
+            return;
+        }
+        epollSetInterest(conn, false);
+        epollMaybeDispatch(conn);  // a pipelined request may be buffered
+    }
+
+    // Move finished responses from the pool into their connections'
+    // outboxes and start writing. A missing id means the client hung up
+    // while its handler was running - the response is simply dropped.
+    void epollDrainCompletions() {
+        vector<CompletedResponse> batch;
+        {
+            lock_guard<mutex> lock(completedMutex);
+            batch.swap(completedResponses);
+        }
+        for (auto& done : batch) {
+            auto it = connections.find(done.connectionId);
+            if (it == connections.end()) continue;
+            EpollConnection* conn = it->second.get();
+            conn->processing = false;
+            conn->outbox = move(done.response);
+            conn->outboxSent = 0;
+            conn->closeAfterSend = !done.keepAlive;
+            epollHandleWritable(conn);
+        }
+    }
+
+    // Reap connections idle past the timeout. Connections with a
+    // handler in flight are exempt - their response is still coming.
+    void epollReapIdle() {
+        auto now = chrono::steady_clock::now();
+        vector<uint64_t> expired;
+        for (const auto& [id, conn] : connections) {
+            if (conn->processing) continue;
+            auto idle = chrono::duration_cast<chrono::seconds>(
+                now - conn->lastActivity);
+            if (idle.count() >= EPOLL_IDLE_TIMEOUT_SECONDS) {
+                expired.push_back(id);
+            }
+        }
+        for (uint64_t id : expired) {
+            epollClose(connections[id].get());
+        }
+    }
+
+public:
+    // Run the epoll event loop until stop(). Mirrors start() from the
+    // outside; only the connection handling differs.
+    void startEpoll() {
+        int serverSocket = openListenSocket();
+        if (serverSocket < 0) {
+            return;
+        }
+        if (!setNonBlocking(serverSocket)) {
+            cerr << "Error making server socket non-blocking" << endl;
+            close(serverSocket);
+            return;
+        }
+
+        epollFd = epoll_create1(0);
+        wakeupFd = eventfd(0, EFD_NONBLOCK);
+        if (epollFd < 0 || wakeupFd < 0) {
+            cerr << "Error creating epoll instance" << endl;
+            if (epollFd >= 0) close(epollFd);
+            if (wakeupFd >= 0) close(wakeupFd);
+            close(serverSocket);
+            return;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = LISTEN_ID;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, serverSocket, &event);
+        event.data.u64 = WAKEUP_ID;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeupFd, &event);
+
+        running = true;
+        cout << "HTTP Server started on port " << port << " (epoll mode)" << endl;
+        cout << "API endpoints available at http://localhost:" << port << "/api/" << endl;
+
+        epoll_event events[128];
+        while (running) {
+            int ready = epoll_wait(epollFd, events, 128, 1000);
+            for (int i = 0; i < ready; i++) {
+                uint64_t id = events[i].data.u64;
+                if (id == LISTEN_ID) {
+                    epollAccept(serverSocket);
+                    continue;
+                }
+                if (id == WAKEUP_ID) {
+                    uint64_t counter;
+                    while (read(wakeupFd, &counter, sizeof(counter)) > 0) {
+                    }
+                    epollDrainCompletions();
+                    continue;
+                }
+
+                // Look the connection up fresh: an earlier event in this
+                // batch (or a drained completion) may have closed it.
+                auto it = connections.find(id);
+                if (it == connections.end()) continue;
+                EpollConnection* conn = it->second.get();
+
+                if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+                    epollClose(conn);
+                    continue;
+                }
+                if (events[i].events & EPOLLOUT) {
+                    epollHandleWritable(conn);
+                    // Writable handling may close the connection
+                    if (connections.find(id) == connections.end()) continue;
+                }
+                if (events[i].events & EPOLLIN) {
+                    epollHandleReadable(conn);
+                }
+            }
+            epollReapIdle();
+        }
+
+        for (auto& [id, conn] : connections) {
+            close(conn->fd);
+        }
+        connections.clear();
+        close(wakeupFd);
+        close(epollFd);
+        close(serverSocket);
+    }
+#endif
 };
 
+#ifndef _WIN32
+// Flush warm caches on a clean shutdown so the next process boots warm.
+// The handler does real work, which signal handlers strictly should
+// not, but losing the accumulated caches on every deploy is the worse
+// trade: the save path only takes short-lived internal locks, and the
+// process exits immediately after.
+static SimpleHTTPServer* g_server = nullptr;
+
+static void handleShutdownSignal(int) {
+    if (g_server) g_server->saveAllWarmCaches();
+    _exit(0);
+}
+#endif
+
 int main(int argc, char* argv[]) {
     if (argc < 4) {
-        cerr << "Usage: " << argv[0] << " <nodes.json> <edges.json> <metadata.json> [port]" << endl;
+        cerr << "Usage: " << argv[0] << " <nodes.json> <edges.json> <metadata.json> [port] [threads|epoll]" << endl;
         return 1;
     }
 
@@ -614,6 +1710,14 @@ int main(int argc, char* argv[]) {
     if (argc >= 5) {
         port = stoi(argv[4]);
     }
+    string mode = "threads";
+    if (argc >= 6) {
+        mode = argv[5];
+        if (mode != "threads" && mode != "epoll") {
+            cerr << "Unknown serving mode '" << mode << "' (expected threads or epoll)" << endl;
+            return 1;
+        }
+    }
 
     fs::path nodesPathFs = fs::absolute(nodesPath);
     fs::path edgesPathFs = fs::absolute(edgesPath);
@@ -651,6 +1755,23 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    #ifndef _WIN32
+    g_server = &server;
+    signal(SIGINT, handleShutdownSignal);
+    signal(SIGTERM, handleShutdownSignal);
+    #endif
+
+    #ifndef _WIN32
+    if (mode == "epoll") {
+        server.startEpoll();
+        return 0;
+    }
+    #else
+    if (mode == "epoll") {
+        cerr << "epoll mode is not available on this platform; using threads" << endl;
+    }
+    #endif
+
     server.start();
     return 0;
 }
@@ -0,0 +1,245 @@
+// include/Backend/benchmark.cpp
+/*
+ * FEATURE BENCHMARK HARNESS
+ * =========================
+ * Timed suites over every Features/ analyzer so a change to any of them
+ * can be compared across releases. test_features.cpp and test/uni_test.cpp
+ * only check correctness; this target measures wall time, throughput and
+ * peak RSS and prints one machine-readable JSON document to stdout
+ * (progress chatter goes to stderr), so runs can be diffed or tracked by
+ * a script.
+ *
+ * Build:
+ *   g++ -std=c++17 -O2 -I. benchmark.cpp -o benchmark -lpthread
+ * Run from the repo root (dataset paths are relative):
+ *   ./benchmark [nodes.json] [edges.json] [metadata.json] [repetitions]
+ */
+
+#include "graph_generator.hpp"
+#include "Algorithm.hpp"
+#include <nlohmann/json.hpp>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using json = nlohmann::json;
+using namespace std;
+
+// Peak resident set size in MiB (0 where getrusage is unavailable).
+// Linux reports ru_maxrss in kilobytes.
+static double peakRssMb() {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss / 1024.0;
+    }
+#endif
+    return 0.0;
+}
+
+/**
+ * Run fn() `operations` times, timing the whole batch, and append one
+ * suite record: total and per-operation wall time, throughput, and the
+ * process peak RSS observed after the suite. A volatile-free sink is
+ * unnecessary - every fn below stores its result into outer state, so
+ * the work cannot be optimized away.
+ */
+static void runSuite(json& suites, const string& name, int operations,
+                     const function<void()>& fn) {
+    cerr << "  running " << name << " (" << operations << " ops)..." << endl;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < operations; i++) {
+        fn();
+    }
+    auto elapsed = chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now() - start);
+
+    double total_ms = elapsed.count() / 1000.0;
+    json suite;
+    suite["name"] = name;
+    suite["operations"] = operations;
+    suite["total_ms"] = total_ms;
+    suite["avg_ms"] = operations > 0 ? total_ms / operations : 0.0;
+    suite["ops_per_sec"] =
+        total_ms > 0.0 ? operations / (total_ms / 1000.0) : 0.0;
+    suite["peak_rss_mb"] = peakRssMb();
+    suites.push_back(move(suite));
+}
+
+// All user ids sorted ascending by friend count - the tails are the
+// low/high-degree tiers, the middle is the medium tier.
+static vector<int> idsByFriendCount(const SocialGraph& graph) {
+    vector<pair<int, int>> by_degree;  // (friend_count, user_id)
+    for (const auto& [id, node] : graph.getNodes()) {
+        by_degree.emplace_back(graph.getFriendCount(id), id);
+    }
+    sort(by_degree.begin(), by_degree.end());
+
+    vector<int> ids;
+    ids.reserve(by_degree.size());
+    for (const auto& [degree, id] : by_degree) {
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+// Pick up to `count` ids spread evenly across [lo, hi) of the
+// degree-sorted order, so a tier isn't dominated by one user.
+static vector<int> sampleRange(const vector<int>& sorted_ids,
+                               size_t lo, size_t hi, size_t count) {
+    vector<int> sample;
+    if (lo >= hi) return sample;
+    size_t span = hi - lo;
+    count = min(count, span);
+    for (size_t i = 0; i < count; i++) {
+        sample.push_back(sorted_ids[lo + i * span / count]);
+    }
+    return sample;
+}
+
+int main(int argc, char* argv[]) {
+    string nodes_path, edges_path, metadata_path;
+    int repetitions = 5;
+
+    if (argc >= 4) {
+        nodes_path = argv[1];
+        edges_path = argv[2];
+        metadata_path = argv[3];
+    } else {
+        // Default paths - adjust these to your dataset
+        nodes_path = "dataset/data/generated/2024-01-01/nodes.json";
+        edges_path = "dataset/data/generated/2024-01-01/edges.json";
+        metadata_path = "dataset/data/generated/2024-01-01/metadata.json";
+    }
+    if (argc >= 5) {
+        repetitions = max(1, atoi(argv[4]));
+    }
+
+    cerr << "Loading graph from " << nodes_path << endl;
+
+    // The graph loaders narrate progress to stdout; route that to
+    // stderr for the duration so stdout stays one clean JSON document.
+    streambuf* cout_buffer = cout.rdbuf(cerr.rdbuf());
+    SocialGraph graph;
+    bool loaded = graph.initializeGraph(nodes_path, edges_path, metadata_path);
+    cout.rdbuf(cout_buffer);
+
+    if (!loaded) {
+        cerr << "ERROR: Failed to initialize graph!" << endl;
+        cerr << "Usage: " << argv[0]
+             << " [nodes.json] [edges.json] [metadata.json] [repetitions]" << endl;
+        return 1;
+    }
+
+    GraphAlgorithms engine(graph);
+    json suites = json::array();
+
+    // --- PageRank -------------------------------------------------------
+    map<int, double> pagerank_sink;
+    runSuite(suites, "pagerank_20_iterations", repetitions, [&] {
+        pagerank_sink = engine.pagerank_calculator.calculate(0.85, 20);
+    });
+
+    // --- Shortest path, cold and warm cache -----------------------------
+    // A fixed spread of source/target pairs across the id space; cold
+    // clears the result cache every pass, warm reuses it.
+    vector<int> degree_sorted = idsByFriendCount(graph);
+    vector<pair<int, int>> path_pairs;
+    {
+        vector<int> endpoints = sampleRange(degree_sorted, 0,
+                                            degree_sorted.size(), 20);
+        for (size_t i = 0; i + 1 < endpoints.size(); i += 2) {
+            path_pairs.emplace_back(endpoints[i], endpoints[i + 1]);
+        }
+    }
+    PathFindResult path_sink;
+    runSuite(suites, "find_path_cold_cache",
+             repetitions * (int)path_pairs.size(), [&, pair_index = 0]() mutable {
+        if (pair_index % path_pairs.size() == 0) {
+            engine.path_calculator.clear_cache();
+        }
+        const auto& [source, target] = path_pairs[pair_index++ % path_pairs.size()];
+        path_sink = engine.path_calculator.find_path(source, target);
+    });
+    runSuite(suites, "find_path_warm_cache",
+             repetitions * (int)path_pairs.size(), [&, pair_index = 0]() mutable {
+        const auto& [source, target] = path_pairs[pair_index++ % path_pairs.size()];
+        path_sink = engine.path_calculator.find_path(source, target);
+    });
+
+    // --- Community detection --------------------------------------------
+    vector<Community> communities_sink;
+    runSuite(suites, "label_propagation", repetitions, [&] {
+        communities_sink = engine.community_detector.detect_label_propagation();
+    });
+
+    // --- Friend recommendations by degree tier --------------------------
+    // Low/medium/high-degree users stress different parts of the scorer:
+    // high-degree users have large two-hop neighbourhoods to scan.
+    size_t n = degree_sorted.size();
+    struct Tier { const char* name; size_t lo, hi; };
+    vector<FriendRecommendation> recommendations_sink;
+    for (const Tier& tier : {Tier{"low_degree", 0, n / 4},
+                             Tier{"medium_degree", n * 3 / 8, n * 5 / 8},
+                             Tier{"high_degree", n * 3 / 4, n}}) {
+        vector<int> users = sampleRange(degree_sorted, tier.lo, tier.hi, 10);
+        if (users.empty()) continue;
+        runSuite(suites, string("recommendations_") + tier.name,
+                 repetitions * (int)users.size(), [&, user_index = 0]() mutable {
+            int user_id = users[user_index++ % users.size()];
+            recommendations_sink =
+                engine.friend_recommender.get_recommendations(user_id, 10);
+        });
+    }
+
+    // --- User search: index build and prefix queries --------------------
+    runSuite(suites, "search_index_build", repetitions, [&] {
+        engine.user_search.buildIndex(graph);
+    });
+    // One- and two-character prefixes taken from real names, so most
+    // queries actually descend into the trie.
+    vector<string> prefixes;
+    for (int id : sampleRange(degree_sorted, 0, degree_sorted.size(), 20)) {
+        const Node* node = graph.getNode(id);
+        if (!node || node->name.empty()) continue;
+        prefixes.push_back(node->name.substr(0, 1));
+        if (node->name.size() >= 2) {
+            prefixes.push_back(node->name.substr(0, 2));
+        }
+    }
+    if (!prefixes.empty()) {
+        vector<int> search_sink;
+        runSuite(suites, "search_prefix_queries",
+                 repetitions * 100, [&, query_index = 0]() mutable {
+            search_sink = engine.user_search.search(
+                prefixes[query_index++ % prefixes.size()], 10);
+        });
+    }
+
+    // --- Influencer leaderboard -----------------------------------------
+    vector<InfluencerRank> leaderboard_sink;
+    runSuite(suites, "influencer_leaderboard_top100", repetitions, [&] {
+        leaderboard_sink = engine.influencer_ranker.get_leaderboard(100, 20);
+    });
+
+    json report;
+    report["dataset"] = {
+        {"nodes_path", nodes_path},
+        {"node_count", graph.getNodeCount()},
+        {"edge_count", graph.getEdgeCount()}
+    };
+    report["repetitions"] = repetitions;
+    report["suites"] = move(suites);
+    report["peak_rss_mb"] = peakRssMb();
+
+    cout << report.dump(2) << endl;
+    return 0;
+}
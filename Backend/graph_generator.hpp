@@ -7,10 +7,20 @@
 #include <unordered_map>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include "string_pool.hpp"
 #include <algorithm>
 #include <cmath>
 #include <chrono>
 #include <set>
+#include <cstdint>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 using json = nlohmann::json;
 using namespace std;
@@ -21,26 +31,85 @@ struct Location {
     double longitude;
 };
 
+// Repeated string fields (interests, relationship types, date stamps)
+// are interned through global_string_pool() and held as 4-byte ids -
+// on a large snapshot the edge list alone used to store millions of
+// copies of "friend". The accessor methods resolve ids on demand; hot
+// loops compare the ids directly.
 struct Node {
     int user_id;
     string name;
     Location location;
     int region_id;
-    vector<string> interests;
-    string created_at;
+    vector<int32_t> interest_ids;  // interned; see interests()
+    int32_t created_at_id = 0;
     set<int> friends;    // Mutual relationships
     set<int> followers;  // Users who follow this user (incoming edges)
     set<int> following;  // Users this user follows (outgoing edges)
+
+    const string& created_at() const {
+        return global_string_pool().resolve(created_at_id);
+    }
+
+    void set_created_at(const string& value) {
+        created_at_id = global_string_pool().intern(value);
+    }
+
+    void add_interest(const string& interest) {
+        interest_ids.push_back(global_string_pool().intern(interest));
+    }
+
+    // Resolved copy for display/serialization paths; scoring loops work
+    // on interest_ids and never pay for this.
+    vector<string> interests() const {
+        vector<string> resolved;
+        resolved.reserve(interest_ids.size());
+        for (int32_t id : interest_ids) {
+            resolved.push_back(global_string_pool().resolve(id));
+        }
+        return resolved;
+    }
 };
 
 struct Edge {
     int source;
     int target;
-    string relationship_type;
+    int32_t relationship_type_id = 0;  // interned
     int message_count;
-    string last_interaction;
+    int32_t last_interaction_id = 0;   // interned
     double distance;
-    string established_at;
+    int32_t established_at_id = 0;     // interned
+
+    const string& relationship_type() const {
+        return global_string_pool().resolve(relationship_type_id);
+    }
+
+    const string& last_interaction() const {
+        return global_string_pool().resolve(last_interaction_id);
+    }
+
+    const string& established_at() const {
+        return global_string_pool().resolve(established_at_id);
+    }
+
+    void set_relationship_type(const string& value) {
+        relationship_type_id = global_string_pool().intern(value);
+    }
+
+    void set_last_interaction(const string& value) {
+        last_interaction_id = global_string_pool().intern(value);
+    }
+
+    void set_established_at(const string& value) {
+        established_at_id = global_string_pool().intern(value);
+    }
+
+    // Friendship checks sit inside the relation-update loops; compare
+    // against the interned id of "friend" instead of resolving.
+    bool is_friend_edge() const {
+        static const int32_t friend_id = global_string_pool().intern("friend");
+        return relationship_type_id == friend_id;
+    }
 };
 
 struct GraphMetadata {
@@ -52,6 +121,141 @@ struct GraphMetadata {
     double average_degree;
 };
 
+/**
+ * Lightweight view over one node's neighbor list inside the CSR arrays.
+ * Iterable with range-for; ids are sorted ascending so membership checks
+ * are a binary search. Views are invalidated whenever the graph is
+ * reloaded or updated (buildAdjacencyIndex rebuilds the arrays).
+ */
+struct NeighborSpan {
+    const int* first = nullptr;
+    const int* last = nullptr;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    int size() const { return static_cast<int>(last - first); }
+    bool empty() const { return first == last; }
+    bool contains(int user_id) const {
+        return binary_search(first, last, user_id);
+    }
+};
+
+// ============== BINARY SNAPSHOT SUPPORT ==============
+// Compact single-file alternative to the three JSON inputs. Loading a
+// snapshot memory-maps the file and walks it with a cursor, so startup
+// is I/O-bound instead of spending minutes building a JSON DOM.
+// Convert existing datasets with the snapshot_converter tool.
+namespace SnapshotFormat {
+    // 8-byte magic at offset 0, bump the digit on layout changes.
+    constexpr char MAGIC[8] = {'S','G','R','A','P','H','0','1'};
+
+    /**
+     * Read-only view of a file. Memory-mapped on POSIX; falls back to a
+     * plain bulk read into a buffer on Windows.
+     */
+    struct MappedFile {
+        const char* data = nullptr;
+        size_t size = 0;
+#ifndef _WIN32
+        void* mapping = nullptr;
+#else
+        vector<char> buffer;
+#endif
+
+        bool open(const string& filepath) {
+#ifndef _WIN32
+            int fd = ::open(filepath.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+                ::close(fd);
+                return false;
+            }
+            mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                return false;
+            }
+            data = static_cast<const char*>(mapping);
+            size = st.st_size;
+            return true;
+#else
+            ifstream file(filepath, ios::binary | ios::ate);
+            if (!file.is_open()) return false;
+            size = file.tellg();
+            file.seekg(0);
+            buffer.resize(size);
+            file.read(buffer.data(), size);
+            data = buffer.data();
+            return file.good();
+#endif
+        }
+
+        ~MappedFile() {
+#ifndef _WIN32
+            if (mapping) munmap(mapping, size);
+#endif
+        }
+    };
+
+    /**
+     * Sequential reader over a mapped snapshot. All reads are bounds
+     * checked; a truncated or corrupt file throws instead of reading
+     * past the mapping.
+     */
+    struct Cursor {
+        const char* pos;
+        const char* end;
+
+        Cursor(const MappedFile& file)
+            : pos(file.data), end(file.data + file.size) {}
+
+        void require(size_t bytes) const {
+            if (pos + bytes > end) {
+                throw runtime_error("Snapshot file truncated or corrupt");
+            }
+        }
+
+        template <typename T>
+        T read() {
+            require(sizeof(T));
+            T value;
+            memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return value;
+        }
+
+        string readString() {
+            uint32_t length = read<uint32_t>();
+            require(length);
+            string value(pos, length);
+            pos += length;
+            return value;
+        }
+    };
+
+    inline void writeString(ofstream& out, const string& value) {
+        uint32_t length = value.size();
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(value.data(), length);
+    }
+
+    template <typename T>
+    inline void writeValue(ofstream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    // Check the magic bytes without reading the whole file.
+    inline bool isSnapshotFile(const string& filepath) {
+        ifstream file(filepath, ios::binary);
+        if (!file.is_open()) return false;
+        char magic[8];
+        file.read(magic, sizeof(magic));
+        return file.gcount() == 8 && memcmp(magic, MAGIC, 8) == 0;
+    }
+}
+
 // ============== GRAPH CLASS ==============
 class SocialGraph {
 private:
@@ -60,6 +264,98 @@ private:
     GraphMetadata metadata;
     string last_update;
 
+    // ===== CSR ADJACENCY (cache-friendly neighbor storage) =====
+    // The per-node std::set adjacency is kept as the mutable source of
+    // truth, but the traversal-heavy algorithms iterate these contiguous
+    // arrays instead of chasing tree nodes. Built by buildAdjacencyIndex()
+    // after every load/update.
+    vector<int> index_to_id;              // dense index -> user_id (sorted)
+    unordered_map<int, int> id_to_index;  // user_id -> dense index
+    vector<int> friend_offsets;           // size V+1, offsets into neighbors
+    vector<int> friend_neighbors;
+    vector<int> follower_offsets;
+    vector<int> follower_neighbors;
+    vector<int> following_offsets;
+    vector<int> following_neighbors;
+    vector<int> fan_counts;               // dense index -> followers minus friends
+
+    // ===== EDGE INDEX (rebuilt together with the CSR arrays) =====
+    // O(1) lookup of the edge record for a node pair, plus per-node
+    // lists of incident edge offsets - replaces full scans of `edges`.
+    unordered_map<long long, int> edge_lookup;   // normalized pair -> offset
+    vector<vector<int>> incident_edges;          // dense index -> edge offsets
+
+    // Bumped by every index rebuild (full load or delta). Dependent
+    // structures (search trie, path caches, landmark index) remember the
+    // version they were built against and refresh lazily on mismatch.
+    uint64_t structure_version = 0;
+
+    // Direction-insensitive pair key; safe for user ids up to 1 billion.
+    static long long encodeEdgeKey(int a, int b) {
+        if (a > b) swap(a, b);
+        return (long long)a * 1000000000LL + b;
+    }
+
+    // Shared sentinel so accessors can hand out references for unknown ids
+    static const set<int>& emptyNeighborSet() {
+        static const set<int> empty;
+        return empty;
+    }
+
+    // Update the per-node relation sets for one edge (both directions
+    // for friendships). Shared by the JSON and snapshot load paths.
+    void applyEdgeRelations(const Edge& edge) {
+        if (nodes.find(edge.source) == nodes.end() ||
+            nodes.find(edge.target) == nodes.end()) {
+            return;
+        }
+        Node& sourceNode = nodes[edge.source];
+        Node& targetNode = nodes[edge.target];
+
+        sourceNode.following.insert(edge.target);
+        targetNode.followers.insert(edge.source);
+
+        if (edge.is_friend_edge()) {
+            sourceNode.friends.insert(edge.target);
+            targetNode.friends.insert(edge.source);
+            sourceNode.followers.insert(edge.target);
+            targetNode.following.insert(edge.source);
+        }
+    }
+
+    // Inverse of applyEdgeRelations: strip the relation entries one edge
+    // contributed. Assumes at most one edge per node pair, which is what
+    // edge_lookup enforces for lookups and the generator emits.
+    void removeEdgeRelations(const Edge& edge) {
+        auto source_it = nodes.find(edge.source);
+        auto target_it = nodes.find(edge.target);
+        if (source_it == nodes.end() || target_it == nodes.end()) {
+            return;
+        }
+        Node& sourceNode = source_it->second;
+        Node& targetNode = target_it->second;
+
+        sourceNode.following.erase(edge.target);
+        targetNode.followers.erase(edge.source);
+
+        if (edge.is_friend_edge()) {
+            sourceNode.friends.erase(edge.target);
+            targetNode.friends.erase(edge.source);
+            sourceNode.followers.erase(edge.target);
+            targetNode.following.erase(edge.source);
+        }
+    }
+
+    static NeighborSpan spanAt(const vector<int>& offsets,
+                               const vector<int>& neighbors,
+                               int index) {
+        if (index < 0 || index + 1 >= static_cast<int>(offsets.size())) {
+            return NeighborSpan();
+        }
+        const int* base = neighbors.data();
+        return NeighborSpan{base + offsets[index], base + offsets[index + 1]};
+    }
+
 public:
     SocialGraph() = default;
 
@@ -84,10 +380,10 @@ public:
                 node.region_id = nodeJSON["region_id"];
 
                 for (const auto& interest : nodeJSON["interests"]) {
-                    node.interests.push_back(interest);
+                    node.add_interest(interest);
                 }
 
-                node.created_at = nodeJSON["created_at"];
+                node.set_created_at(nodeJSON["created_at"]);
                 node.friends.clear();
                 node.followers.clear();
                 node.following.clear();
@@ -120,48 +416,21 @@ public:
 
                 edge.source = edgeJSON.value("source", -1);
                 edge.target = edgeJSON.value("target", -1);
-                edge.relationship_type = edgeJSON.value("relationship_type", "");
+                edge.set_relationship_type(edgeJSON.value("relationship_type", ""));
                 edge.message_count     = edgeJSON.value("message_count", 0);
 
                 // Handle null values for string fields
-                edge.last_interaction  = edgeJSON.contains("last_interaction") && !edgeJSON["last_interaction"].is_null() 
-                                         ? edgeJSON["last_interaction"].get<string>() : "";
-                edge.distance          = edgeJSON.value("distance", 0.0);
-                edge.established_at    = edgeJSON.value("established_at", "");
-                
-                // edge.relationship_type =
-                //     edgeJSON.contains("relationship_type") && edgeJSON["relationship_type"].is_string()
-                //     ? edgeJSON["relationship_type"].get<string>()
-                //     : "";
-
-                edge.last_interaction =
+                edge.set_last_interaction(
                     edgeJSON.contains("last_interaction") && edgeJSON["last_interaction"].is_string()
                     ? edgeJSON["last_interaction"].get<string>()
-                    : "";
-
-                //  edge.established_at =
-                //     edgeJSON.contains("established_at") && edgeJSON["established_at"].is_string()
-                //     ? edgeJSON["established_at"].get<string>()
-                //     : "";
+                    : "");
+                edge.distance          = edgeJSON.value("distance", 0.0);
+                edge.set_established_at(edgeJSON.value("established_at", ""));
 
                 edges.push_back(edge);
 
                 // Update directional relationship caches when both nodes exist
-                if (nodes.find(edge.source) != nodes.end() && 
-                    nodes.find(edge.target) != nodes.end()) {
-                    Node& sourceNode = nodes[edge.source];
-                    Node& targetNode = nodes[edge.target];
-
-                    sourceNode.following.insert(edge.target);
-                    targetNode.followers.insert(edge.source);
-
-                    if (edge.relationship_type == "friend") {
-                        sourceNode.friends.insert(edge.target);
-                        targetNode.friends.insert(edge.source);
-                        sourceNode.followers.insert(edge.target);
-                        targetNode.following.insert(edge.source);
-                    }
-                }
+                applyEdgeRelations(edge);
             }
 
             cout << "✓ Loaded " << edges.size() << " edges" << endl;
@@ -199,18 +468,261 @@ public:
         }
     }
 
+    // ========== BINARY SNAPSHOT I/O ==========
+
+    /**
+     * Write the loaded graph as a single binary snapshot file.
+     * Layout: magic, metadata, node records, edge records. Adjacency
+     * sets are not stored - they are rebuilt from the edges on load,
+     * exactly like the JSON path does.
+     */
+    bool saveSnapshot(const string& filepath) const {
+        using namespace SnapshotFormat;
+        try {
+            ofstream out(filepath, ios::binary | ios::trunc);
+            if (!out.is_open()) {
+                cerr << "Cannot open snapshot file for writing: " << filepath << endl;
+                return false;
+            }
+
+            out.write(MAGIC, sizeof(MAGIC));
+
+            writeString(out, metadata.date);
+            writeValue<int32_t>(out, metadata.total_nodes);
+            writeValue<int32_t>(out, metadata.total_edges);
+            writeValue<int32_t>(out, metadata.friend_relationships);
+            writeValue<int32_t>(out, metadata.fan_relationships);
+            writeValue<double>(out, metadata.average_degree);
+
+            writeValue<uint32_t>(out, nodes.size());
+            for (const auto& [id, node] : nodes) {
+                writeValue<int32_t>(out, node.user_id);
+                writeValue<int32_t>(out, node.region_id);
+                writeValue<double>(out, node.location.latitude);
+                writeValue<double>(out, node.location.longitude);
+                writeString(out, node.name);
+                writeString(out, node.created_at());
+                writeValue<uint32_t>(out, node.interest_ids.size());
+                for (int32_t interest_id : node.interest_ids) {
+                    writeString(out, global_string_pool().resolve(interest_id));
+                }
+            }
+
+            writeValue<uint64_t>(out, edges.size());
+            for (const auto& edge : edges) {
+                writeValue<int32_t>(out, edge.source);
+                writeValue<int32_t>(out, edge.target);
+                writeValue<int32_t>(out, edge.message_count);
+                writeValue<double>(out, edge.distance);
+                writeString(out, edge.relationship_type());
+                writeString(out, edge.last_interaction());
+                writeString(out, edge.established_at());
+            }
+
+            cout << "✓ Saved snapshot to " << filepath << endl;
+            return out.good();
+        } catch (const exception& e) {
+            cerr << "Error saving snapshot: " << e.what() << endl;
+            return false;
+        }
+    }
+
+    /**
+     * Load the graph from a binary snapshot produced by saveSnapshot.
+     * The file is memory-mapped and consumed with bulk sequential reads;
+     * no intermediate DOM is built.
+     */
+    bool loadFromSnapshot(const string& filepath) {
+        using namespace SnapshotFormat;
+        try {
+            MappedFile file;
+            if (!file.open(filepath)) {
+                cerr << "Cannot open snapshot file: " << filepath << endl;
+                return false;
+            }
+
+            Cursor cursor(file);
+            cursor.require(sizeof(MAGIC));
+            if (memcmp(cursor.pos, MAGIC, sizeof(MAGIC)) != 0) {
+                cerr << "Not a graph snapshot file: " << filepath << endl;
+                return false;
+            }
+            cursor.pos += sizeof(MAGIC);
+
+            metadata.date = cursor.readString();
+            metadata.total_nodes = cursor.read<int32_t>();
+            metadata.total_edges = cursor.read<int32_t>();
+            metadata.friend_relationships = cursor.read<int32_t>();
+            metadata.fan_relationships = cursor.read<int32_t>();
+            metadata.average_degree = cursor.read<double>();
+
+            nodes.clear();
+            uint32_t node_count = cursor.read<uint32_t>();
+            nodes.reserve(node_count);
+            for (uint32_t i = 0; i < node_count; i++) {
+                Node node;
+                node.user_id = cursor.read<int32_t>();
+                node.region_id = cursor.read<int32_t>();
+                node.location.latitude = cursor.read<double>();
+                node.location.longitude = cursor.read<double>();
+                node.name = cursor.readString();
+                node.set_created_at(cursor.readString());
+                uint32_t interest_count = cursor.read<uint32_t>();
+                node.interest_ids.reserve(interest_count);
+                for (uint32_t j = 0; j < interest_count; j++) {
+                    node.add_interest(cursor.readString());
+                }
+                nodes[node.user_id] = move(node);
+            }
+            cout << "✓ Loaded " << nodes.size() << " nodes" << endl;
+
+            edges.clear();
+            uint64_t edge_count = cursor.read<uint64_t>();
+            edges.reserve(edge_count);
+            for (uint64_t i = 0; i < edge_count; i++) {
+                Edge edge;
+                edge.source = cursor.read<int32_t>();
+                edge.target = cursor.read<int32_t>();
+                edge.message_count = cursor.read<int32_t>();
+                edge.distance = cursor.read<double>();
+                edge.set_relationship_type(cursor.readString());
+                edge.set_last_interaction(cursor.readString());
+                edge.set_established_at(cursor.readString());
+                applyEdgeRelations(edge);
+                edges.push_back(move(edge));
+            }
+            cout << "✓ Loaded " << edges.size() << " edges" << endl;
+
+            return true;
+        } catch (const exception& e) {
+            cerr << "Error loading snapshot: " << e.what() << endl;
+            return false;
+        }
+    }
+
+    /**
+     * Build the CSR adjacency arrays from the per-node sets.
+     * Called automatically at the end of initializeGraph / updateGraph;
+     * call manually after mutating adjacency through other paths.
+     *
+     * Layout: one dense index per node (user ids sorted ascending), then
+     * for each relation an offsets array of size V+1 and a flat neighbor
+     * array. std::set iteration is already sorted, so each CSR row comes
+     * out sorted for free.
+     */
+    void buildAdjacencyIndex() {
+        int node_count = nodes.size();
+
+        index_to_id.clear();
+        index_to_id.reserve(node_count);
+        for (const auto& [id, node] : nodes) {
+            index_to_id.push_back(id);
+        }
+        sort(index_to_id.begin(), index_to_id.end());
+
+        id_to_index.clear();
+        id_to_index.reserve(node_count);
+        for (int i = 0; i < node_count; i++) {
+            id_to_index[index_to_id[i]] = i;
+        }
+
+        auto build_relation = [&](vector<int>& offsets, vector<int>& neighbors,
+                                  const set<int> Node::* relation) {
+            offsets.assign(node_count + 1, 0);
+            size_t total = 0;
+            for (int i = 0; i < node_count; i++) {
+                total += (nodes.at(index_to_id[i]).*relation).size();
+            }
+            neighbors.clear();
+            neighbors.reserve(total);
+            for (int i = 0; i < node_count; i++) {
+                const auto& relation_set = nodes.at(index_to_id[i]).*relation;
+                neighbors.insert(neighbors.end(),
+                                 relation_set.begin(), relation_set.end());
+                offsets[i + 1] = neighbors.size();
+            }
+        };
+
+        build_relation(friend_offsets, friend_neighbors, &Node::friends);
+        build_relation(follower_offsets, follower_neighbors, &Node::followers);
+        build_relation(following_offsets, following_neighbors, &Node::following);
+
+        // Fan counts (followers that are not also friends), derived once
+        // from the freshly built rows. Both rows are sorted, so the set
+        // difference is a two-pointer sweep; influencer scoring then
+        // reads a counter instead of re-walking follower sets per call.
+        fan_counts.assign(node_count, 0);
+        for (int i = 0; i < node_count; i++) {
+            NeighborSpan followers =
+                spanAt(follower_offsets, follower_neighbors, i);
+            NeighborSpan friend_row =
+                spanAt(friend_offsets, friend_neighbors, i);
+            const int* f = friend_row.begin();
+            int fans = 0;
+            for (const int* p = followers.begin(); p != followers.end(); ++p) {
+                while (f != friend_row.end() && *f < *p) ++f;
+                if (f == friend_row.end() || *f != *p) fans++;
+            }
+            fan_counts[i] = fans;
+        }
+
+        // Edge index: pair lookup keeps the first edge recorded for a
+        // pair (matching the old linear-scan semantics), incident lists
+        // record every edge offset touching a node.
+        edge_lookup.clear();
+        edge_lookup.reserve(edges.size());
+        incident_edges.assign(node_count, {});
+        for (int e = 0; e < (int)edges.size(); e++) {
+            const Edge& edge = edges[e];
+            edge_lookup.emplace(encodeEdgeKey(edge.source, edge.target), e);
+
+            int source_index = getNodeIndex(edge.source);
+            int target_index = getNodeIndex(edge.target);
+            if (source_index >= 0) incident_edges[source_index].push_back(e);
+            if (target_index >= 0 && target_index != source_index) {
+                incident_edges[target_index].push_back(e);
+            }
+        }
+
+        structure_version++;
+    }
+
     // ========== MAIN PUBLIC METHODS FOR EXTERNAL USE ==========
 
+    // Initialize graph from a binary snapshot file (see saveSnapshot)
+    bool initializeGraph(const string& snapshotFile) {
+        cout << "\n=== Initializing Graph (snapshot) ===" << endl;
+
+        if (!loadFromSnapshot(snapshotFile)) return false;
+
+        buildAdjacencyIndex();
+
+        auto now = chrono::system_clock::now();
+        auto time = chrono::system_clock::to_time_t(now);
+        last_update = ctime(&time);
+
+        cout << "✓ Graph initialized successfully" << endl;
+        return true;
+    }
+
     // Initialize graph from JSON files (CALL THIS FIRST FROM FRONTEND)
-    bool initializeGraph(const string& nodesFile, 
-                        const string& edgesFile, 
+    // If nodesFile is actually a binary snapshot, it is loaded directly
+    // and the other two paths are ignored.
+    bool initializeGraph(const string& nodesFile,
+                        const string& edgesFile,
                         const string& metadataFile) {
+        if (SnapshotFormat::isSnapshotFile(nodesFile)) {
+            return initializeGraph(nodesFile);
+        }
+
         cout << "\n=== Initializing Graph ===" << endl;
-        
+
         if (!loadNodesFromJSON(nodesFile)) return false;
         if (!loadEdgesFromJSON(edgesFile)) return false;
         if (!loadMetadataFromJSON(metadataFile)) return false;
 
+        buildAdjacencyIndex();
+
         auto now = chrono::system_clock::now();
         auto time = chrono::system_clock::to_time_t(now);
         last_update = ctime(&time);
@@ -221,70 +733,140 @@ public:
 
     // Update graph with new data (CALL THIS DAILY FROM FRONTEND)
     // How it works:
-    // 1. Stores backup of current state in case update fails
-    // 2. Clears relationship caches in all nodes (friends/followers/following)
-    // 3. Loads new nodes - NEW NODES are added, EXISTING nodes are updated
-    // 4. Loads new edges - rebuilds all adjacency relationships
-    // 5. If any step fails, restores from backup (transaction-like behavior)
-    // This way: if dataset adds new users or modifies existing ones, graph adapts
-    bool updateGraph(const string& nodesFile, 
-                    const string& edgesFile, 
+    // 1. Loads the new day's data into a scratch SocialGraph off to the
+    //    side - the live state is never touched during the load
+    // 2. On success, move-assigns the scratch graph over this one in one
+    //    cheap pointer-stealing swap; on any failure the scratch graph is
+    //    simply dropped and the current state survives untouched
+    // Peak memory during a refresh is old + new. The previous scheme
+    // copied nodes/edges/metadata into backups before reloading in place
+    // (2x old + new), which has OOM-killed the server on large snapshots.
+    // Long-running readers that must not observe the swap should hold the
+    // graph behind a shared_ptr and swap the pointer instead, as the API
+    // server's per-date GraphContext does.
+    bool updateGraph(const string& nodesFile,
+                    const string& edgesFile,
                     const string& metadataFile) {
         cout << "\n=== Updating Graph ===" << endl;
-        
-        // Backup current state
-        auto nodesBackup = nodes;
-        auto edgesBackup = edges;
-        auto metadataBackup = metadata;
 
+        SocialGraph fresh;
         try {
-            // Clear relationship caches but keep nodes - for fresh rebuild
-            for (auto& [id, node] : nodes) {
-                node.friends.clear();
-                node.followers.clear();
-                node.following.clear();
-            }
-
-            // Load new data
-            if (!loadNodesFromJSON(nodesFile)) {
-                nodes = nodesBackup;
-                edges = edgesBackup;
-                metadata = metadataBackup;
-                cout << "✗ Failed to load nodes, reverting to previous state" << endl;
+            if (!fresh.loadNodesFromJSON(nodesFile)) {
+                cout << "✗ Failed to load nodes, keeping previous state" << endl;
                 return false;
             }
 
-            if (!loadEdgesFromJSON(edgesFile)) {
-                nodes = nodesBackup;
-                edges = edgesBackup;
-                metadata = metadataBackup;
-                cout << "✗ Failed to load edges, reverting to previous state" << endl;
+            if (!fresh.loadEdgesFromJSON(edgesFile)) {
+                cout << "✗ Failed to load edges, keeping previous state" << endl;
                 return false;
             }
 
-            if (!loadMetadataFromJSON(metadataFile)) {
-                nodes = nodesBackup;
-                edges = edgesBackup;
-                metadata = metadataBackup;
-                cout << "✗ Failed to load metadata, reverting to previous state" << endl;
+            if (!fresh.loadMetadataFromJSON(metadataFile)) {
+                cout << "✗ Failed to load metadata, keeping previous state" << endl;
                 return false;
             }
 
+            fresh.buildAdjacencyIndex();
+
             auto now = chrono::system_clock::now();
             auto time = chrono::system_clock::to_time_t(now);
-            last_update = ctime(&time);
+            fresh.last_update = ctime(&time);
+
+            // Keep the version monotonic across the swap so dependent
+            // caches built against the old graph always see a change
+            fresh.structure_version = structure_version + 1;
+            *this = move(fresh);
 
             cout << "✓ Graph updated successfully" << endl;
             return true;
         } catch (const exception& e) {
-            nodes = nodesBackup;
-            edges = edgesBackup;
-            metadata = metadataBackup;
             cerr << "✗ Exception during update: " << e.what() << endl;
             return false;
         }
     }
 
+    // ========== INCREMENTAL DELTA UPDATES ==========
+    // Day-over-day snapshots differ by a few percent of edges, so a full
+    // reload (re-parsing every JSON record) wastes minutes to apply
+    // seconds of change. These methods patch the in-memory graph
+    // directly and rebuild only the derived index in one linear pass.
+
+    /**
+     * Insert a new user or refresh an existing user's profile fields
+     * (name, location, region, interests, created_at). Relationship sets
+     * of existing users are preserved - connectivity is owned by the
+     * edge delta. Call applyEdgeDelta (or buildAdjacencyIndex) afterwards
+     * so new users get a dense index slot.
+     */
+    void upsertNode(const Node& node) {
+        auto it = nodes.find(node.user_id);
+        if (it == nodes.end()) {
+            nodes[node.user_id] = node;
+            return;
+        }
+        Node& existing = it->second;
+        existing.name = node.name;
+        existing.location = node.location;
+        existing.region_id = node.region_id;
+        existing.interest_ids = node.interest_ids;
+        existing.created_at_id = node.created_at_id;
+    }
+
+    /**
+     * Apply an edge delta: removed edges are matched by endpoint pair
+     * (either direction, the relationship type on record wins), added
+     * edges follow the same rules as the JSON loader (both endpoints
+     * must exist, friendships are mutual). The adjacency and edge
+     * indexes are rebuilt once at the end and the structure version is
+     * bumped, so dependent caches refresh lazily on their next query.
+     *
+     * Cost: O(delta * log degree) set surgery plus one O(V + E) index
+     * rebuild - no JSON parsing, no snapshot copies.
+     */
+    void applyEdgeDelta(const vector<Edge>& added_edges,
+                        const vector<Edge>& removed_edges) {
+        if (added_edges.empty() && removed_edges.empty()) return;
+
+        if (!removed_edges.empty()) {
+            set<long long> removed_keys;
+            for (const Edge& removal : removed_edges) {
+                long long key = encodeEdgeKey(removal.source, removal.target);
+                auto it = edge_lookup.find(key);
+                if (it == edge_lookup.end()) continue;
+                removeEdgeRelations(edges[it->second]);
+                removed_keys.insert(key);
+            }
+
+            // Compact the edge list in one pass
+            vector<Edge> kept;
+            kept.reserve(edges.size());
+            for (Edge& edge : edges) {
+                if (!removed_keys.count(encodeEdgeKey(edge.source, edge.target))) {
+                    kept.push_back(move(edge));
+                }
+            }
+            edges = move(kept);
+        }
+
+        for (const Edge& edge : added_edges) {
+            if (nodes.find(edge.source) == nodes.end() ||
+                nodes.find(edge.target) == nodes.end()) {
+                continue;
+            }
+            edges.push_back(edge);
+            applyEdgeRelations(edge);
+        }
+
+        metadata.total_nodes = nodes.size();
+        metadata.total_edges = edges.size();
+
+        buildAdjacencyIndex();
+
+        auto now = chrono::system_clock::now();
+        auto time = chrono::system_clock::to_time_t(now);
+        last_update = ctime(&time);
+    }
+
     // ========== ACCESSOR METHODS FOR ALGORITHMS ==========
 
     const Node* getNode(int user_id) const {
@@ -294,38 +876,57 @@ public:
 
     vector<Edge> getEdgesForNode(int user_id) const {
         vector<Edge> result;
-        for (const auto& edge : edges) {
-            if (edge.source == user_id || edge.target == user_id) {
-                result.push_back(edge);
-            }
+        const vector<int>& offsets = edgesOf(user_id);
+        result.reserve(offsets.size());
+        for (int offset : offsets) {
+            result.push_back(edges[offset]);
         }
         return result;
     }
 
-    set<int> getFriends(int user_id) const {
+    /**
+     * O(1) lookup of the edge between two users (either direction).
+     * Returns nullptr if no edge exists. The pointer is invalidated
+     * when the graph is reloaded or updated.
+     */
+    const Edge* findEdge(int user1, int user2) const {
+        auto it = edge_lookup.find(encodeEdgeKey(user1, user2));
+        return (it != edge_lookup.end()) ? &edges[it->second] : nullptr;
+    }
+
+    // Offsets into getEdges() of every edge incident to this user.
+    const vector<int>& edgesOf(int user_id) const {
+        static const vector<int> empty;
+        int index = getNodeIndex(user_id);
+        return (index >= 0 && index < (int)incident_edges.size())
+               ? incident_edges[index] : empty;
+    }
+
+    // Neighbor accessors return const references to the stored sets
+    // (an empty sentinel for unknown users) - callers iterate them in
+    // place, nothing is copied. Prefer the NeighborSpan accessors below
+    // in traversal-heavy loops.
+    const set<int>& getFriends(int user_id) const {
         const auto* node = getNode(user_id);
-        return node ? node->friends : set<int>();
+        return node ? node->friends : emptyNeighborSet();
     }
 
-    set<int> getFollowers(int user_id) const {
+    const set<int>& getFollowers(int user_id) const {
         const auto* node = getNode(user_id);
-        return node ? node->followers : set<int>();
+        return node ? node->followers : emptyNeighborSet();
     }
 
-    set<int> getFollowing(int user_id) const {
+    const set<int>& getFollowing(int user_id) const {
         const auto* node = getNode(user_id);
-        return node ? node->following : set<int>();
+        return node ? node->following : emptyNeighborSet();
     }
 
     /**
      * Convenience helper for traversals: all outgoing connections
      * (friends already included because friendship implies following).
      */
-    set<int> getReachableConnections(int user_id) const {
-        const auto* node = getNode(user_id);
-        if (!node) return {};
-        set<int> reachable = node->following;
-        return reachable;
+    const set<int>& getReachableConnections(int user_id) const {
+        return getFollowing(user_id);
     }
     
     int getFriendCount(int user_id) const {
@@ -333,6 +934,67 @@ public:
         return node ? node->friends.size() : 0;
     }
 
+    // ===== CSR ACCESSORS (zero-copy, for hot traversal loops) =====
+
+    // Monotonic counter incremented on every index rebuild. Dependent
+    // structures compare it against the version they indexed to decide
+    // whether their cached state is still valid.
+    uint64_t getStructureVersion() const {
+        return structure_version;
+    }
+
+    // Dense index for a user id, or -1 if the id is unknown.
+    int getNodeIndex(int user_id) const {
+        auto it = id_to_index.find(user_id);
+        return (it != id_to_index.end()) ? it->second : -1;
+    }
+
+    int getUserIdAtIndex(int index) const {
+        return (index >= 0 && index < (int)index_to_id.size())
+               ? index_to_id[index] : -1;
+    }
+
+    int getIndexedNodeCount() const {
+        return index_to_id.size();
+    }
+
+    NeighborSpan friendsOf(int user_id) const {
+        return spanAt(friend_offsets, friend_neighbors, getNodeIndex(user_id));
+    }
+
+    NeighborSpan followersOf(int user_id) const {
+        return spanAt(follower_offsets, follower_neighbors, getNodeIndex(user_id));
+    }
+
+    NeighborSpan followingOf(int user_id) const {
+        return spanAt(following_offsets, following_neighbors, getNodeIndex(user_id));
+    }
+
+    // Index-based variants for algorithms that already work in dense
+    // index space (avoids the id -> index hash lookup per visit).
+    NeighborSpan friendsAtIndex(int index) const {
+        return spanAt(friend_offsets, friend_neighbors, index);
+    }
+
+    NeighborSpan followersAtIndex(int index) const {
+        return spanAt(follower_offsets, follower_neighbors, index);
+    }
+
+    NeighborSpan followingAtIndex(int index) const {
+        return spanAt(following_offsets, following_neighbors, index);
+    }
+
+    // Fans = followers that are not also friends, precomputed by
+    // buildAdjacencyIndex. 0 for unknown ids.
+    int getFanCount(int user_id) const {
+        return fanCountAtIndex(getNodeIndex(user_id));
+    }
+
+    int fanCountAtIndex(int index) const {
+        return (index >= 0 && index < (int)fan_counts.size())
+               ? fan_counts[index] : 0;
+    }
+
     const unordered_map<int, Node>& getNodes() const {
         return nodes;
     }
@@ -345,6 +1007,13 @@ public:
         return metadata;
     }
 
+    // Replace the metadata record wholesale. Used by producers that
+    // build a graph in memory (e.g. the synthesizer) instead of loading
+    // metadata.json; the JSON and snapshot loaders fill it themselves.
+    void setMetadata(const GraphMetadata& meta) {
+        metadata = meta;
+    }
+
     int getNodeCount() const {
         return nodes.size();
     }
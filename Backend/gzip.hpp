@@ -0,0 +1,223 @@
+// include/Backend/gzip.hpp
+/*
+ * GZIP COMPRESSION
+ * ================
+ * Self-contained gzip encoder (RFC 1951/1952) so large API payloads can
+ * be stored and served compressed without an external zlib dependency.
+ * Uses DEFLATE with the fixed Huffman tables and a greedy LZ77 matcher -
+ * not zlib-level ratios, but a fraction of the size on JSON text and any
+ * standard client can decode it.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+namespace Gzip {
+
+    // ===== CRC32 (gzip trailer) =====
+    inline uint32_t crc32(const string& data) {
+        static uint32_t table[256];
+        static bool table_built = false;
+        if (!table_built) {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                table[i] = c;
+            }
+            table_built = true;
+        }
+        uint32_t c = 0xFFFFFFFFu;
+        for (unsigned char byte : data) {
+            c = table[(c ^ byte) & 0xFF] ^ (c >> 8);
+        }
+        return c ^ 0xFFFFFFFFu;
+    }
+
+    // ===== BIT STREAM (LSB-first per RFC 1951) =====
+    struct BitWriter {
+        string out;
+        uint64_t bit_buffer = 0;
+        int bit_count = 0;
+
+        void put_bits(uint32_t bits, int count) {
+            bit_buffer |= (uint64_t)bits << bit_count;
+            bit_count += count;
+            while (bit_count >= 8) {
+                out.push_back((char)(bit_buffer & 0xFF));
+                bit_buffer >>= 8;
+                bit_count -= 8;
+            }
+        }
+
+        // Huffman codes are transmitted most-significant-bit first
+        void put_code(uint32_t code, int length) {
+            uint32_t reversed = 0;
+            for (int i = 0; i < length; i++) {
+                reversed = (reversed << 1) | ((code >> i) & 1);
+            }
+            put_bits(reversed, length);
+        }
+
+        void flush() {
+            if (bit_count > 0) {
+                out.push_back((char)(bit_buffer & 0xFF));
+                bit_buffer = 0;
+                bit_count = 0;
+            }
+        }
+    };
+
+    // Fixed Huffman literal codes (RFC 1951 section 3.2.6)
+    inline void write_literal(BitWriter& bw, int literal) {
+        if (literal < 144) {
+            bw.put_code(0x30 + literal, 8);
+        } else {
+            bw.put_code(0x190 + (literal - 144), 9);
+        }
+    }
+
+    inline void write_length(BitWriter& bw, int length) {
+        static const int base[29] = {
+            3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,
+            67,83,99,115,131,163,195,227,258};
+        static const int extra[29] = {
+            0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0};
+
+        int code = 28;
+        while (code > 0 && base[code] > length) code--;
+
+        int symbol = 257 + code;
+        if (symbol < 280) {
+            bw.put_code(symbol - 256, 7);
+        } else {
+            bw.put_code(0xC0 + (symbol - 280), 8);
+        }
+        if (extra[code] > 0) {
+            bw.put_bits(length - base[code], extra[code]);
+        }
+    }
+
+    inline void write_distance(BitWriter& bw, int distance) {
+        static const int base[30] = {
+            1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,
+            1025,1537,2049,3073,4097,6145,8193,12289,16385,24577};
+        static const int extra[30] = {
+            0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
+
+        int code = 29;
+        while (code > 0 && base[code] > distance) code--;
+
+        bw.put_code(code, 5);
+        if (extra[code] > 0) {
+            bw.put_bits(distance - base[code], extra[code]);
+        }
+    }
+
+    /**
+     * Greedy LZ77 + fixed-Huffman DEFLATE, emitted as one final block.
+     * A single-slot hash with short chains keeps matching cheap; JSON
+     * payloads compress well anyway thanks to their repeated keys.
+     */
+    inline string deflate_fixed(const string& input) {
+        constexpr int WINDOW_SIZE = 32768;
+        constexpr int MIN_MATCH = 3;
+        constexpr int MAX_MATCH = 258;
+        constexpr int MAX_CHAIN = 32;
+        constexpr int HASH_BITS = 15;
+        constexpr int HASH_SIZE = 1 << HASH_BITS;
+
+        BitWriter bw;
+        bw.put_bits(1, 1);  // final block
+        bw.put_bits(1, 2);  // fixed Huffman trees
+
+        int n = input.size();
+        vector<int> head(HASH_SIZE, -1);
+        vector<int> prev(n, -1);
+
+        auto hash_at = [&](int pos) {
+            uint32_t h = (uint8_t)input[pos] << 10 ^
+                         (uint8_t)input[pos + 1] << 5 ^
+                         (uint8_t)input[pos + 2];
+            return (int)(h & (HASH_SIZE - 1));
+        };
+
+        int pos = 0;
+        while (pos < n) {
+            int best_length = 0;
+            int best_distance = 0;
+
+            if (pos + MIN_MATCH <= n) {
+                int h = hash_at(pos);
+                int candidate = head[h];
+                int chain = 0;
+                int max_length = min(MAX_MATCH, n - pos);
+
+                while (candidate >= 0 && pos - candidate <= WINDOW_SIZE &&
+                       chain < MAX_CHAIN) {
+                    int length = 0;
+                    while (length < max_length &&
+                           input[candidate + length] == input[pos + length]) {
+                        length++;
+                    }
+                    if (length > best_length) {
+                        best_length = length;
+                        best_distance = pos - candidate;
+                        if (length == max_length) break;
+                    }
+                    candidate = prev[candidate];
+                    chain++;
+                }
+
+                prev[pos] = head[h];
+                head[h] = pos;
+            }
+
+            if (best_length >= MIN_MATCH) {
+                write_length(bw, best_length);
+                write_distance(bw, best_distance);
+                // Index the skipped positions so later matches find them
+                int match_end = min(pos + best_length, n - MIN_MATCH + 1);
+                for (int p = pos + 1; p < match_end; p++) {
+                    int h = hash_at(p);
+                    prev[p] = head[h];
+                    head[h] = p;
+                }
+                pos += best_length;
+            } else {
+                write_literal(bw, (uint8_t)input[pos]);
+                pos++;
+            }
+        }
+
+        bw.put_code(0, 7);  // end-of-block symbol 256
+        bw.flush();
+        return move(bw.out);
+    }
+
+    /**
+     * Compress a buffer into a complete gzip stream (header + deflate
+     * body + CRC32/size trailer).
+     */
+    inline string compress(const string& input) {
+        string out;
+        // Header: magic, deflate, no flags, no mtime, unknown OS
+        const unsigned char header[10] = {
+            0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+        out.append((const char*)header, sizeof(header));
+
+        out += deflate_fixed(input);
+
+        uint32_t crc = crc32(input);
+        uint32_t size = (uint32_t)input.size();
+        for (int i = 0; i < 4; i++) out.push_back((char)((crc >> (8 * i)) & 0xFF));
+        for (int i = 0; i < 4; i++) out.push_back((char)((size >> (8 * i)) & 0xFF));
+        return out;
+    }
+}
@@ -0,0 +1,142 @@
+// include/Backend/lru_cache.hpp
+/*
+ * SHARDED LRU CACHE
+ * =================
+ * Bounded, thread-safe key/value cache for memoizing expensive query
+ * results. Entries are spread over shards by key hash, each shard with
+ * its own lock and LRU list, so concurrent readers on different shards
+ * never serialize. Hit/miss/eviction counters are kept in atomics for
+ * cheap instrumentation.
+ */
+
+#pragma once
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+using namespace std;
+
+template <typename Key, typename Value>
+class ShardedLRUCache {
+private:
+    struct Shard {
+        mutex mtx;
+        // front = most recently used; evictions pop from the back
+        list<pair<Key, Value>> order;
+        unordered_map<Key, typename list<pair<Key, Value>>::iterator> index;
+    };
+
+    vector<unique_ptr<Shard>> shards;
+    size_t per_shard_capacity;
+    mutable atomic<uint64_t> hit_count{0};
+    mutable atomic<uint64_t> miss_count{0};
+    atomic<uint64_t> eviction_count{0};
+
+    Shard& shardFor(const Key& key) const {
+        size_t h = hash<Key>{}(key);
+        return *shards[h % shards.size()];
+    }
+
+public:
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        size_t entries;
+    };
+
+    /**
+     * total_capacity is split evenly across shards; each shard evicts
+     * its own least-recently-used entry once it exceeds its slice.
+     */
+    explicit ShardedLRUCache(size_t total_capacity, size_t shard_count = 16) {
+        if (shard_count == 0) shard_count = 1;
+        per_shard_capacity = total_capacity / shard_count;
+        if (per_shard_capacity == 0) per_shard_capacity = 1;
+        shards.reserve(shard_count);
+        for (size_t i = 0; i < shard_count; i++) {
+            shards.push_back(make_unique<Shard>());
+        }
+    }
+
+    // Copy the cached value into out and refresh its recency.
+    bool get(const Key& key, Value& out) const {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> lock(shard.mtx);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            miss_count.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+        shard.order.splice(shard.order.begin(), shard.order, it->second);
+        out = it->second->second;
+        hit_count.fetch_add(1, memory_order_relaxed);
+        return true;
+    }
+
+    void put(const Key& key, Value value) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> lock(shard.mtx);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            it->second->second = move(value);
+            shard.order.splice(shard.order.begin(), shard.order, it->second);
+            return;
+        }
+
+        shard.order.emplace_front(key, move(value));
+        shard.index[key] = shard.order.begin();
+
+        if (shard.order.size() > per_shard_capacity) {
+            shard.index.erase(shard.order.back().first);
+            shard.order.pop_back();
+            eviction_count.fetch_add(1, memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Visit every cached entry, least-recently-used first within each
+     * shard. Built for persistence: replaying the visited entries back
+     * through put() reproduces the recency ordering.
+     */
+    void forEach(const function<void(const Key&, const Value&)>& fn) const {
+        for (const auto& shard : shards) {
+            lock_guard<mutex> lock(shard->mtx);
+            for (auto it = shard->order.rbegin(); it != shard->order.rend(); ++it) {
+                fn(it->first, it->second);
+            }
+        }
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards) {
+            lock_guard<mutex> lock(shard->mtx);
+            total += shard->order.size();
+        }
+        return total;
+    }
+
+    void clear() {
+        for (auto& shard : shards) {
+            lock_guard<mutex> lock(shard->mtx);
+            shard->order.clear();
+            shard->index.clear();
+        }
+    }
+
+    Stats stats() const {
+        return Stats{
+            hit_count.load(memory_order_relaxed),
+            miss_count.load(memory_order_relaxed),
+            eviction_count.load(memory_order_relaxed),
+            size()
+        };
+    }
+};
@@ -0,0 +1,107 @@
+// include/Backend/metrics.hpp
+/*
+ * REQUEST METRICS
+ * ===============
+ * Lock-free latency histograms for permanent hot-path instrumentation.
+ * Recording a sample is two relaxed atomic increments (plus a CAS only
+ * when a new maximum is seen), so timers can stay on in production.
+ * Percentiles are approximate: samples land in power-of-two microsecond
+ * buckets and a percentile reports its bucket's upper edge.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+class LatencyHistogram {
+private:
+    // Bucket b holds samples in [2^b, 2^(b+1)) microseconds (bucket 0
+    // covers 0-1us); 32 buckets span over an hour.
+    static constexpr int BUCKET_COUNT = 32;
+
+    atomic<uint64_t> buckets[BUCKET_COUNT] = {};
+    atomic<uint64_t> total_count{0};
+    atomic<uint64_t> max_micros{0};
+
+    static int bucketFor(uint64_t micros) {
+        int bucket = 0;
+        while (micros > 1 && bucket < BUCKET_COUNT - 1) {
+            micros >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+public:
+    void record(uint64_t micros) {
+        buckets[bucketFor(micros)].fetch_add(1, memory_order_relaxed);
+        total_count.fetch_add(1, memory_order_relaxed);
+
+        uint64_t previous = max_micros.load(memory_order_relaxed);
+        while (micros > previous &&
+               !max_micros.compare_exchange_weak(previous, micros,
+                                                 memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const {
+        return total_count.load(memory_order_relaxed);
+    }
+
+    uint64_t maxMicros() const {
+        return max_micros.load(memory_order_relaxed);
+    }
+
+    /**
+     * Approximate percentile in microseconds (quantile in [0, 1]):
+     * walks the bucket counts to the requested rank and returns that
+     * bucket's upper edge. Concurrent writers may skew a snapshot by a
+     * few samples, which is irrelevant for monitoring.
+     */
+    uint64_t percentileMicros(double quantile) const {
+        uint64_t snapshot[BUCKET_COUNT];
+        uint64_t total = 0;
+        for (int b = 0; b < BUCKET_COUNT; b++) {
+            snapshot[b] = buckets[b].load(memory_order_relaxed);
+            total += snapshot[b];
+        }
+        if (total == 0) return 0;
+
+        uint64_t rank = (uint64_t)(quantile * total);
+        if (rank >= total) rank = total - 1;
+
+        uint64_t cumulative = 0;
+        for (int b = 0; b < BUCKET_COUNT; b++) {
+            cumulative += snapshot[b];
+            if (cumulative > rank) {
+                return b == 0 ? 1 : (uint64_t)1 << (b + 1);
+            }
+        }
+        return maxMicros();
+    }
+};
+
+/**
+ * Records the elapsed wall time into a histogram when it goes out of
+ * scope. Place one at the top of a handler and every exit path is
+ * covered, exceptions included.
+ */
+class ScopedLatencyTimer {
+private:
+    LatencyHistogram& histogram;
+    chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedLatencyTimer(LatencyHistogram& h)
+        : histogram(h), start(chrono::steady_clock::now()) {}
+
+    ~ScopedLatencyTimer() {
+        auto elapsed = chrono::duration_cast<chrono::microseconds>(
+            chrono::steady_clock::now() - start);
+        histogram.record((uint64_t)elapsed.count());
+    }
+};
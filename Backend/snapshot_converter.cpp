@@ -0,0 +1,52 @@
+// Backend/snapshot_converter.cpp
+/*
+ * SNAPSHOT CONVERTER
+ * ==================
+ * One-time converter from the nodes/edges/metadata JSON files to the
+ * compact binary snapshot format understood by SocialGraph.
+ *
+ * Compile: g++ -std=c++17 -O2 -I. snapshot_converter.cpp -o snapshot_converter
+ * Run:     ./snapshot_converter <nodes.json> <edges.json> <metadata.json> <out.bin>
+ */
+
+#include "graph_generator.hpp"
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        cerr << "Usage: " << argv[0]
+             << " <nodes.json> <edges.json> <metadata.json> <output.bin>" << endl;
+        return 1;
+    }
+
+    SocialGraph graph;
+    if (!graph.initializeGraph(argv[1], argv[2], argv[3])) {
+        cerr << "ERROR: Failed to load JSON dataset" << endl;
+        return 1;
+    }
+
+    if (!graph.saveSnapshot(argv[4])) {
+        cerr << "ERROR: Failed to write snapshot" << endl;
+        return 1;
+    }
+
+    // Sanity check: reload the snapshot and compare counts
+    SocialGraph reloaded;
+    if (!reloaded.initializeGraph(argv[4])) {
+        cerr << "ERROR: Snapshot verification reload failed" << endl;
+        return 1;
+    }
+    if (reloaded.getNodeCount() != graph.getNodeCount() ||
+        reloaded.getEdgeCount() != graph.getEdgeCount()) {
+        cerr << "ERROR: Snapshot verification mismatch ("
+             << reloaded.getNodeCount() << "/" << graph.getNodeCount() << " nodes, "
+             << reloaded.getEdgeCount() << "/" << graph.getEdgeCount() << " edges)" << endl;
+        return 1;
+    }
+
+    cout << "\n✓ Conversion complete: " << argv[4] << endl;
+    return 0;
+}
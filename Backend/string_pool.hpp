@@ -0,0 +1,87 @@
+// include/Backend/string_pool.hpp
+/*
+ * STRING INTERNING POOL
+ * =====================
+ * Deduplicates the repeated strings node and edge records carry -
+ * interests, relationship types and date stamps. On a large snapshot
+ * the edge list alone stores millions of copies of "friend"; interned,
+ * each distinct value is stored once and records hold a 4-byte id.
+ * Equality checks between interned values become integer compares.
+ *
+ * Ids are dense, start at 0 (always the empty string, so a
+ * default-constructed id resolves to "") and are never recycled.
+ * intern() takes the writer lock only for values not seen before;
+ * resolve() takes a shared lock and returns a reference that stays
+ * valid for the pool's lifetime (storage is a deque, so growth never
+ * moves existing entries).
+ */
+
+#pragma once
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <cstdint>
+
+using namespace std;
+
+class StringPool {
+private:
+    deque<string> strings;              // id -> value, references stable
+    unordered_map<string, int32_t> ids; // value -> id
+    mutable shared_mutex pool_mutex;
+
+public:
+    StringPool() {
+        strings.push_back("");
+        ids[""] = 0;
+    }
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // Return the id for value, adding it to the pool on first sight.
+    // Fast path is a shared-lock lookup; the exclusive lock is only
+    // taken for genuinely new values.
+    int32_t intern(const string& value) {
+        {
+            shared_lock<shared_mutex> lock(pool_mutex);
+            auto it = ids.find(value);
+            if (it != ids.end()) return it->second;
+        }
+
+        unique_lock<shared_mutex> lock(pool_mutex);
+        auto it = ids.find(value);  // lost a race? someone added it
+        if (it != ids.end()) return it->second;
+
+        int32_t id = (int32_t)strings.size();
+        strings.push_back(value);
+        ids[strings.back()] = id;
+        return id;
+    }
+
+    // Resolve an id back to its string. Out-of-range ids (including the
+    // default 0) resolve to the empty string rather than faulting.
+    const string& resolve(int32_t id) const {
+        shared_lock<shared_mutex> lock(pool_mutex);
+        if (id < 0 || id >= (int32_t)strings.size()) {
+            return strings.front();
+        }
+        return strings[id];
+    }
+
+    size_t size() const {
+        shared_lock<shared_mutex> lock(pool_mutex);
+        return strings.size();
+    }
+};
+
+// Process-wide pool shared by every graph instance. Interned ids are
+// only comparable against ids from the same pool, so there is exactly
+// one - same pattern as global_thread_pool().
+inline StringPool& global_string_pool() {
+    static StringPool pool;
+    return pool;
+}
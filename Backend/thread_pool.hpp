@@ -0,0 +1,131 @@
+// include/Backend/thread_pool.hpp
+/*
+ * THREAD POOL
+ * ===========
+ * Fixed-size worker pool shared by the parallel algorithms and the API
+ * server. Workers sleep on a condition variable and pull tasks from a
+ * single queue; parallel_blocks() is a convenience for data-parallel
+ * loops over index ranges.
+ */
+
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+class ThreadPool {
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex queue_mutex;
+    condition_variable task_available;
+    bool stopping = false;
+
+    void worker_loop() {
+        while (true) {
+            function<void()> task;
+            {
+                unique_lock<mutex> lock(queue_mutex);
+                task_available.wait(lock, [this] {
+                    return stopping || !tasks.empty();
+                });
+                if (stopping && tasks.empty()) return;
+                task = move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t thread_count = 0) {
+        if (thread_count == 0) {
+            thread_count = max(1u, thread::hardware_concurrency());
+        }
+        workers.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; i++) {
+            workers.emplace_back(&ThreadPool::worker_loop, this);
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            stopping = true;
+        }
+        task_available.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const {
+        return workers.size();
+    }
+
+    void enqueue(function<void()> task) {
+        {
+            lock_guard<mutex> lock(queue_mutex);
+            tasks.push(move(task));
+        }
+        task_available.notify_one();
+    }
+
+    /**
+     * Split [0, total) into one contiguous chunk per worker and run
+     * fn(chunk_begin, chunk_end) on the pool, blocking until every
+     * chunk has finished.
+     *
+     * Must not be called from a pool worker itself (the caller blocks
+     * waiting for tasks the occupied workers would have to run).
+     */
+    void parallel_blocks(int total, const function<void(int, int)>& fn) {
+        if (total <= 0) return;
+
+        int chunk_count = min<int>(workers.size(), total);
+        if (chunk_count <= 1) {
+            fn(0, total);
+            return;
+        }
+
+        atomic<int> remaining(chunk_count);
+        mutex done_mutex;
+        condition_variable all_done;
+
+        int chunk_size = (total + chunk_count - 1) / chunk_count;
+        for (int c = 0; c < chunk_count; c++) {
+            int begin = c * chunk_size;
+            int end = min(total, begin + chunk_size);
+            enqueue([&, begin, end] {
+                fn(begin, end);
+                if (remaining.fetch_sub(1) == 1) {
+                    lock_guard<mutex> lock(done_mutex);
+                    all_done.notify_one();
+                }
+            });
+        }
+
+        unique_lock<mutex> lock(done_mutex);
+        all_done.wait(lock, [&] { return remaining.load() == 0; });
+    }
+};
+
+/**
+ * Process-wide pool for CPU-heavy algorithm work. Sized to the machine;
+ * created lazily on first use.
+ */
+inline ThreadPool& global_thread_pool() {
+    static ThreadPool pool;
+    return pool;
+}
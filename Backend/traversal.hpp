@@ -0,0 +1,93 @@
+// include/traversal.hpp
+/*
+ * DENSE-INDEX TRAVERSAL CORE
+ * ==========================
+ * Shared scratch state for breadth-first work over the CSR arrays.
+ * The graph already owns the stable user-id -> dense-index mapping
+ * (SocialGraph::getNodeIndex / getUserIdAtIndex); this header supplies
+ * the per-traversal state every algorithm used to rebuild on its own:
+ * a visited bitset, flat distance/parent arrays and the frontier queue.
+ *
+ * Resetting between runs does not clear the whole bitset. Each run
+ * records which 64-bit words it dirtied and reset() zeroes only those,
+ * so back-to-back traversals that touch a few hundred nodes of a
+ * million-node graph pay O(touched) instead of O(V) per run. (The
+ * distance/parent arrays are never cleared at all - their values are
+ * only meaningful where the seen bit is set.)
+ *
+ * A scratch instance is not thread-safe; give each thread its own
+ * (the adopters keep one per worker, usually as a thread_local).
+ * mark()/seen() alone also serve as a cheap O(touched)-reset member
+ * set, which the community helpers use for dense membership probes.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+class BFSScratch {
+private:
+    vector<uint64_t> seen_bits;    // one bit per dense node index
+    vector<size_t> touched_words;  // bitset words dirtied since reset()
+    vector<int> dist_v;            // valid only where the seen bit is set
+    vector<int> parent_v;          // valid only where the seen bit is set
+    vector<int> fifo;              // frontier storage, doubles as visit order
+    size_t head = 0;
+
+public:
+    /**
+     * Prepare for a traversal over node_count dense indices. Reuses all
+     * prior allocations; only the words the previous run touched are
+     * zeroed.
+     */
+    void reset(int node_count) {
+        size_t words = ((size_t)node_count + 63) / 64;
+        if (seen_bits.size() < words) {
+            seen_bits.assign(words, 0);
+        } else {
+            for (size_t w : touched_words) seen_bits[w] = 0;
+        }
+        touched_words.clear();
+        if ((int)dist_v.size() < node_count) {
+            dist_v.resize(node_count);
+            parent_v.resize(node_count);
+        }
+        fifo.clear();
+        head = 0;
+    }
+
+    bool seen(int v) const {
+        return (seen_bits[(size_t)v >> 6] >> (v & 63)) & 1u;
+    }
+
+    // Record v as reached with its distance and BFS-tree parent
+    // (parent -1 at a root). Does not enqueue - callers that cap depth
+    // decide separately whether v joins the frontier.
+    void mark(int v, int distance, int parent) {
+        size_t w = (size_t)v >> 6;
+        if (seen_bits[w] == 0) touched_words.push_back(w);
+        seen_bits[w] |= 1ULL << (v & 63);
+        dist_v[v] = distance;
+        parent_v[v] = parent;
+    }
+
+    void enqueue(int v) { fifo.push_back(v); }
+
+    // Nodes still waiting in the frontier (one BFS level at a time is
+    // just a loop over the pending() count captured up front).
+    size_t pending() const { return fifo.size() - head; }
+    int pop() { return fifo[head++]; }
+
+    int dist(int v) const { return dist_v[v]; }
+    int parent(int v) const { return parent_v[v]; }
+
+    /**
+     * Every index enqueued so far, in BFS order. Brandes walks this
+     * backwards for its dependency accumulation.
+     */
+    const vector<int>& visit_order() const { return fifo; }
+};